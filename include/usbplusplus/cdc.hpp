@@ -100,6 +100,33 @@ enum class CdcDescriptorSubType_t : uint8_t {
 	NCM							= 0x1A,
 };
 
+/* Interface class, functional descriptors belong to, subclasses vary */
+constexpr ClassCode_t interfaceclass(CdcDescriptorSubType_t) { return ClassCode_t::CDC; }
+
+/* Table 19: Class-Specific Request Codes */
+enum class CdcRequestCode_t : uint8_t {
+	SEND_ENCAPSULATED_COMMAND	= 0x00,
+	GET_ENCAPSULATED_RESPONSE	= 0x01,
+	SET_COMM_FEATURE			= 0x02,
+	GET_COMM_FEATURE			= 0x03,
+	CLEAR_COMM_FEATURE			= 0x04,
+	SET_AUX_LINE_STATE			= 0x10,
+	SET_HOOK_STATE				= 0x11,
+	PULSE_SETUP					= 0x12,
+	SEND_PULSE					= 0x13,
+	SET_PULSE_TIME				= 0x14,
+	RING_AUX_JACK				= 0x15,
+	SET_LINE_CODING				= 0x20,
+	GET_LINE_CODING				= 0x21,
+	SET_CONTROL_LINE_STATE		= 0x22,
+	SEND_BREAK					= 0x23,
+	SET_ETHERNET_MULTICAST_FILTERS				= 0x40,
+	SET_ETHERNET_POWER_MANAGEMENT_PATTERN_FILTER	= 0x41,
+	GET_ETHERNET_POWER_MANAGEMENT_PATTERN_FILTER	= 0x42,
+	SET_ETHERNET_PACKET_FILTER	= 0x43,
+	GET_ETHERNET_STATISTIC		= 0x44,
+};
+
 enum class CallManagementCapabilities_t : uint8_t {
 	/**
 	 * 0 - Device sends/receives call management information only over the Communications Class 
@@ -1,6 +1,6 @@
 /* Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
  *
- * dispatch.hpp - Dispatcher for Standard Device Requests
+ * dispatch.hpp - Dispatcher and router for Device Requests
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"),
@@ -25,6 +25,8 @@
 
 #pragma once
 #include <usbplusplus/usbplusplus.hpp>
+#include <type_traits>
+#include <utility>
 #if __cplusplus < 201703L
 #error "Dispatcher requires c++17 or higher"
 #endif
@@ -63,6 +65,88 @@ inline constexpr bool operator==(RequestType request_type, any_device2host_recip
     return any_recipient == request_type;
 }
 
+// Request code a condition is bound to, or -1 if the condition does not expose it
+template<typename When, typename = void>
+struct code_of : std::integral_constant<int, -1> {};
+
+template<typename When>
+struct code_of<When, std::void_t<decltype(When::code)>>
+  : std::integral_constant<int, static_cast<int>(When::code)> {};
+
+// Descriptor type a GET_DESCRIPTOR condition is bound to, or -1 if the condition does not expose it
+template<typename When, typename = void>
+struct descriptor_of : std::integral_constant<int, -1> {};
+
+template<typename When>
+struct descriptor_of<When, std::void_t<decltype(When::descriptor)>>
+  : std::integral_constant<int, static_cast<int>(When::descriptor)> {};
+
+template<typename ... Values>
+constexpr int max_of(int first, Values ... values) {
+    ((first = values > first ? values : first), ...);
+    return first;
+}
+
+// Condition for a Class or Vendor request, optionally narrowed to a recipient and a request code.
+// Request codes of these types overlap with the standard ones, so code is not exposed
+template<RequestType_t Type, auto ... Params>
+struct nonstandard_request;
+
+template<RequestType_t Type>
+struct nonstandard_request<Type> {
+    constexpr bool operator==(StandardDeviceRequest request) const {
+        return request.request_type() == Type;
+    }
+};
+
+template<RequestType_t Type, auto Recipient>
+struct nonstandard_request<Type, Recipient> {
+    constexpr bool operator==(StandardDeviceRequest request) const {
+        return request.request_type() == Type && request.recipient() == Recipient;
+    }
+};
+
+template<RequestType_t Type, auto Recipient, auto Code>
+struct nonstandard_request<Type, Recipient, Code> {
+    constexpr bool operator==(StandardDeviceRequest request) const {
+        return request.request_type() == Type && request.recipient() == Recipient &&
+               static_cast<uint8_t>(request.bRequest) == static_cast<uint8_t>(Code);
+    }
+};
+
+// Map of interfaces declared in a configuration and of endpoints to interfaces they belong to
+struct route_map {
+    static constexpr unsigned slots = endpoint_slots;
+    static constexpr unsigned slot(unsigned address) {
+        return endpoint_slot(address);
+    }
+    template<typename Descriptor>
+    static constexpr route_map of(const Descriptor& configuration) {
+        route_map map {};
+        walk(map, configuration);
+        return map;
+    }
+    constexpr bool declared(unsigned number) const {
+        return number < interfaces && (declared_interfaces[number / 8] & (1 << (number % 8)));
+    }
+    template<typename Interface>
+    constexpr void interface(const Interface& descriptor, unsigned) {
+        const uint8_t number = descriptor.bInterfaceNumber.get();
+        current = number;
+        declared_interfaces[number / 8] = static_cast<uint8_t>(declared_interfaces[number / 8] | 1 << (number % 8));
+        interfaces = number < interfaces ? interfaces : number + 1u;
+    }
+    template<typename Endpoint>
+    constexpr void endpoint(const Endpoint& descriptor, unsigned) {
+        owners[slot(descriptor.bEndpointAddress.get())] = static_cast<uint8_t>(current + 1);
+    }
+    // Number of interface, the endpoint belongs to, plus one, or zero if there is no such endpoint
+    uint8_t owners[slots] {};
+    uint8_t declared_interfaces[256 / 8] {};
+    unsigned interfaces {};
+    uint8_t current {};
+};
+
 }
 namespace dispatch {
 using usb1::RequestCode;
@@ -76,6 +160,7 @@ struct when;
 
 template<>
 struct when<RequestCode::CLEAR_FEATURE> {
+    static constexpr RequestCode code = RequestCode::CLEAR_FEATURE;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::CLEAR_FEATURE &&
                request.bmRequestType == detail::any_host2device_recipient{};
@@ -84,6 +169,7 @@ struct when<RequestCode::CLEAR_FEATURE> {
 
 template<auto Recipient>
 struct when<RequestCode::CLEAR_FEATURE, Recipient> {
+    static constexpr RequestCode code = RequestCode::CLEAR_FEATURE;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::CLEAR_FEATURE &&
                request.bmRequestType == detail::standard_host2device(Recipient);
@@ -92,6 +178,7 @@ struct when<RequestCode::CLEAR_FEATURE, Recipient> {
 
 template<>
 struct when<RequestCode::GET_CONFIGURATION> {
+    static constexpr RequestCode code = RequestCode::GET_CONFIGURATION;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::GET_CONFIGURATION &&
                request.bmRequestType == detail::standard_device2host(Recipient_t::Device);
@@ -100,6 +187,7 @@ struct when<RequestCode::GET_CONFIGURATION> {
 
 template<>
 struct when<RequestCode::GET_DESCRIPTOR>{
+    static constexpr RequestCode code = RequestCode::GET_DESCRIPTOR;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::GET_DESCRIPTOR &&
                request.bmRequestType == detail::standard_device2host(Recipient_t::Device);
@@ -108,6 +196,7 @@ struct when<RequestCode::GET_DESCRIPTOR>{
 
 template<>
 struct when<RequestCode::GET_INTERFACE>{
+    static constexpr RequestCode code = RequestCode::GET_INTERFACE;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::GET_INTERFACE &&
                request.bmRequestType == detail::standard_device2host(Recipient_t::Interface);
@@ -116,6 +205,7 @@ struct when<RequestCode::GET_INTERFACE>{
 
 template<>
 struct when<RequestCode::GET_STATUS>{
+    static constexpr RequestCode code = RequestCode::GET_STATUS;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::GET_STATUS &&
                request.bmRequestType == detail::any_device2host_recipient{};
@@ -124,6 +214,7 @@ struct when<RequestCode::GET_STATUS>{
 
 template<auto Recipient>
 struct when<RequestCode::GET_STATUS, Recipient>{
+    static constexpr RequestCode code = RequestCode::GET_STATUS;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::GET_STATUS &&
                request.bmRequestType == detail::standard_device2host(Recipient);
@@ -132,6 +223,7 @@ struct when<RequestCode::GET_STATUS, Recipient>{
 
 template<>
 struct when<RequestCode::SET_ADDRESS>{
+    static constexpr RequestCode code = RequestCode::SET_ADDRESS;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::SET_ADDRESS &&
                request.bmRequestType == detail::standard_host2device(Recipient_t::Device);
@@ -140,6 +232,7 @@ struct when<RequestCode::SET_ADDRESS>{
 
 template<>
 struct when<RequestCode::SET_CONFIGURATION>{
+    static constexpr RequestCode code = RequestCode::SET_CONFIGURATION;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::SET_CONFIGURATION &&
                request.bmRequestType == detail::standard_host2device(Recipient_t::Device);
@@ -148,6 +241,7 @@ struct when<RequestCode::SET_CONFIGURATION>{
 
 template<>
 struct when<RequestCode::SET_DESCRIPTOR>{
+    static constexpr RequestCode code = RequestCode::SET_DESCRIPTOR;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::SET_DESCRIPTOR &&
                request.bmRequestType == detail::standard_host2device(Recipient_t::Device);
@@ -156,6 +250,7 @@ struct when<RequestCode::SET_DESCRIPTOR>{
 
 template<>
 struct when<RequestCode::SET_FEATURE>{
+    static constexpr RequestCode code = RequestCode::SET_FEATURE;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::SET_FEATURE &&
                request.bmRequestType == detail::any_host2device_recipient{};
@@ -164,6 +259,7 @@ struct when<RequestCode::SET_FEATURE>{
 
 template<auto Recipient>
 struct when<RequestCode::SET_FEATURE, Recipient>{
+    static constexpr RequestCode code = RequestCode::SET_FEATURE;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::SET_FEATURE &&
                request.bmRequestType == detail::standard_host2device(Recipient);
@@ -172,6 +268,7 @@ struct when<RequestCode::SET_FEATURE, Recipient>{
 
 template<>
 struct when<RequestCode::SET_INTERFACE>{
+    static constexpr RequestCode code = RequestCode::SET_INTERFACE;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::SET_INTERFACE && (
                request.bmRequestType == detail::standard_host2device(Recipient_t::Interface));
@@ -180,6 +277,7 @@ struct when<RequestCode::SET_INTERFACE>{
 
 template<>
 struct when<RequestCode::SYNCH_FRAME>{
+    static constexpr RequestCode code = RequestCode::SYNCH_FRAME;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.bRequest == RequestCode::SYNCH_FRAME && (
                request.bmRequestType == detail::standard_device2host(Recipient_t::Endpoint));
@@ -188,17 +286,36 @@ struct when<RequestCode::SYNCH_FRAME>{
 
 template<auto DescriptorType>
 struct when<DescriptorType>{
+    static constexpr RequestCode code = RequestCode::GET_DESCRIPTOR;
+    static constexpr auto descriptor = DescriptorType;
     constexpr bool operator==(StandardDeviceRequest request) const {
         return request.descriptor_type() == DescriptorType &&
-                request == when<RequestCode::GET_DESCRIPTOR>{};
+               when<RequestCode::GET_DESCRIPTOR>{} == request;
     }
 };
 
+// Class and Vendor requests: when<RequestType_t::Class>, when<RequestType_t::Class, Recipient_t::Interface>,
+// when<RequestType_t::Class, Recipient_t::Interface, cdc::CdcRequestCode_t::SET_LINE_CODING>
+template<>
+struct when<RequestType_t::Class> : detail::nonstandard_request<RequestType_t::Class> {};
+
+template<auto Recipient, auto ... Code>
+struct when<RequestType_t::Class, Recipient, Code...>
+  : detail::nonstandard_request<RequestType_t::Class, Recipient, Code...> {};
+
+template<>
+struct when<RequestType_t::Vendor> : detail::nonstandard_request<RequestType_t::Vendor> {};
+
+template<auto Recipient, auto ... Code>
+struct when<RequestType_t::Vendor, Recipient, Code...>
+  : detail::nonstandard_request<RequestType_t::Vendor, Recipient, Code...> {};
+
 // Dispatches request, matching When conditions to Function
 // Function is expected to return false only if the request is not intended for handling in its scope
 // Otherwise It should return true, regardless of its execution success
 template<auto Function, auto When>
 struct to {
+    using condition = decltype(When);
     template<typename Request, typename ... Params>
     bool operator()(Request request, Params&& ... params) const {
         if (When == request) {
@@ -217,5 +334,129 @@ struct dispatcher {
     }
 };
 
+// Dispatches request to one of the Items via jump tables, built at compile time.
+// The first table is indexed by bRequest, the second, for GET_DESCRIPTOR, by the descriptor type,
+// so the cost of a request does not depend on the number of Items.
+// Each entry tries, in the declared order, only the Items that may match it, including those with
+// a condition that does not tell its request code, so the outcome is the same as with dispatcher
+template <typename ... Item>
+class indexed_dispatcher {
+    static constexpr int codes = static_cast<int>(RequestCode::SYNCH_FRAME) + 1;
+    static constexpr int descriptors = detail::max_of(-1, detail::descriptor_of<typename Item::condition>::value...) + 1;
+    static constexpr int get_descriptor = static_cast<int>(RequestCode::GET_DESCRIPTOR);
+
+    template<typename Request, typename ... Params>
+    using handler = bool (*)(const Request&, Params& ...);
+
+    // Whether Item may match a request with the given code and descriptor type
+    template<typename When>
+    static constexpr bool candidate(int code, int type) {
+        constexpr int when_code = detail::code_of<When>::value;
+        constexpr int when_type = detail::descriptor_of<When>::value;
+        return when_code < 0 || (when_code == code && (when_type < 0 || when_type == type));
+    }
+
+    template<typename Request, typename ... Params>
+    static bool unbound(const Request& request, Params& ... params) {
+        return ((detail::code_of<typename Item::condition>::value < 0 && Item{}(request, params...)) || ...);
+    }
+
+    template<int Code, typename Request, typename ... Params>
+    static bool by_code(const Request& request, Params& ... params) {
+        return ((candidate<typename Item::condition>(Code, -1) && Item{}(request, params...)) || ...);
+    }
+
+    template<int Type, typename Request, typename ... Params>
+    static bool by_descriptor(const Request& request, Params& ... params) {
+        return ((candidate<typename Item::condition>(get_descriptor, Type) && Item{}(request, params...)) || ...);
+    }
+
+    template<typename Sequence, typename Request, typename ... Params>
+    struct table;
+
+    template<int ... Index, typename Request, typename ... Params>
+    struct table<std::integer_sequence<int, Index...>, Request, Params...> {
+        static constexpr handler<Request, Params...> by_request[] = { &by_code<Index, Request, Params...> ... };
+        static constexpr handler<Request, Params...> by_type[] = { &by_descriptor<Index, Request, Params...> ... };
+    };
+
+    template<typename Request, typename ... Params>
+    static bool by_descriptor_type(const Request& request, Params& ... params) {
+        if constexpr (descriptors > 0) {
+            using types = table<std::make_integer_sequence<int, descriptors>, Request, Params...>;
+            const auto type = static_cast<unsigned>(request.descriptor_type());
+            if (type < static_cast<unsigned>(descriptors)) {
+                return types::by_type[type](request, params...);
+            }
+        }
+        return by_code<get_descriptor>(request, params...);
+    }
+
+public:
+    template<typename Request, typename ... Params>
+    bool operator()(Request request, Params&& ... params) const {
+        using requests = table<std::make_integer_sequence<int, codes>, Request, Params...>;
+        const auto code = static_cast<unsigned>(request.bRequest);
+        if (code == static_cast<unsigned>(get_descriptor)) {
+            return by_descriptor_type(request, params...);
+        }
+        return code < static_cast<unsigned>(codes) ? requests::by_request[code](request, params...)
+                                                   : unbound(request, params...);
+    }
+};
+
+// Route of requests, addressed to interface Number or to any of its endpoints, to Handler.
+// Handler is a callable type, such as dispatcher or to
+template<uint8_t Number, typename Handler>
+struct on_interface {
+    static constexpr uint8_t number = Number;
+    using handler = Handler;
+};
+
+// Routes requests with Interface or Endpoint recipient to one of the Routes by wIndex.
+// Interfaces and endpoints of the Config are mapped at compile time, so a request for an endpoint reaches
+// the route of its interface, and the lookup is a table access regardless of the number of routes.
+// Requests with other recipients are not handled
+template<const auto& Config, typename ... Route>
+class router {
+    static constexpr detail::route_map map = detail::route_map::of(Config);
+    static_assert((map.declared(Route::number) && ...), "Route refers to an interface not declared in the configuration");
+
+    template<typename Request, typename ... Params>
+    using handler = bool (*)(const Request&, Params& ...);
+
+    template<unsigned Number, typename Request, typename ... Params>
+    static bool to_interface(const Request& request, Params& ... params) {
+        return ((Route::number == Number && typename Route::handler{}(request, params...)) || ...);
+    }
+
+    template<typename Sequence, typename Request, typename ... Params>
+    struct table;
+
+    template<unsigned ... Number, typename Request, typename ... Params>
+    struct table<std::integer_sequence<unsigned, Number...>, Request, Params...> {
+        static constexpr handler<Request, Params...> by_interface[] = { &to_interface<Number, Request, Params...> ... };
+    };
+
+public:
+    template<typename Request, typename ... Params>
+    bool operator()(Request request, Params&& ... params) const {
+        using interfaces = table<std::make_integer_sequence<unsigned, map.interfaces>, Request, Params...>;
+        const unsigned index = request.wIndex.get() & 0xFF;
+        unsigned number;
+        switch (request.recipient()) {
+        case Recipient_t::Interface:
+            number = index;
+            break;
+        case Recipient_t::Endpoint:
+            number = map.owners[detail::route_map::slot(index)] - 1u;
+            break;
+        default:
+            return false;
+        }
+        return number < map.interfaces && interfaces::by_interface[number](request, params...);
+    }
+};
+
 } // namespace dispatch
 } // namespace usbplusplus
@@ -0,0 +1,146 @@
+/* Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * feedback.hpp - Feedback value generator for asynchronous audio endpoints
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+#include <usbplusplus/usbplusplus.hpp>
+#include <cstdint>
+#if __cplusplus < 201703L
+#error "Feedback generator requires c++17 or higher"
+#endif
+
+/*
+ * USB 2.0, 5.12.4.2 Feedback
+ * Ff is the number of samples per (micro)frame the device consumes or
+ * produces, sent in 10.14 format, 3 bytes, at full speed and in 16.16
+ * format, 4 bytes, at high speed.
+ */
+
+namespace usbplusplus {
+namespace feedback {
+
+// Format of the feedback value at the bus speed
+template<BusSpeed_t Speed>
+struct format {
+    static constexpr unsigned fraction_bits = Speed == BusSpeed_t::Full ? 14 : 16;
+    static constexpr unsigned size = Speed == BusSpeed_t::Full ? 3 : 4;
+    static constexpr uint32_t frames_per_second = Speed == BusSpeed_t::Full ? 1000 : 8000;
+    // Ff for the sample rate, rounded to nearest, for initialization and tests
+    static constexpr uint32_t of(uint32_t sample_rate) {
+        return static_cast<uint32_t>(((static_cast<uint64_t>(sample_rate) << fraction_bits) +
+            frames_per_second / 2) / frames_per_second);
+    }
+};
+
+// Generates Ff for the feedback Endpoint, a usb2::Endpoint, from the sample
+// clock of the device, counted at each SOF. The counter may tick
+// 2^Resolution times per sample, e.g. Resolution 8 for a counter of a
+// 256 fs master clock. Ticks, counted over 2^(bInterval-1) (micro)frames,
+// are shifted to the fixed point format and smoothed by an exponential
+// filter with weight 2^-Filter. The level of the audio buffer, if reported,
+// shifts Ff by 2^-Gain samples per (micro)frame per sample away from the
+// target level. sof() and occupancy() take shifts, additions and no division.
+// A plain sample counter, Resolution 0, measures whole samples, the filter
+// leaves a ripple of about 2^-Filter sample per (micro)frame, ~90 ppm at
+// 44.1 kHz, full speed and Filter 8, which the buffer level, if reported,
+// averages out. Count a faster clock to settle Ff within a few ppm.
+// Usage:
+//   constexpr usb2::Endpoint myFeedback = { ..., MaxPacketSize(4), Interval(4) };
+//   feedback::generator<myFeedback, BusSpeed_t::High, 8, 8, 8> fb { feedback::format<BusSpeed_t::High>::of(48000) };
+//   void on_sof() { if( fb.sof(mclk_counter) ) send(fb.data(), fb.size); }
+template<const auto& Endpoint, BusSpeed_t Speed, unsigned Filter = 8, unsigned Gain = 8,
+    unsigned Resolution = 0>
+class generator {
+    static constexpr const usb2::Endpoint& endpoint = Endpoint;
+    static constexpr unsigned binterval = endpoint.bInterval.get();
+public:
+    using format_type = format<Speed>;
+    static constexpr unsigned fraction_bits = format_type::fraction_bits;
+    static constexpr unsigned size = format_type::size;
+    // (micro)frames between updates of Ff
+    static constexpr unsigned period = 1u << (binterval - 1);
+    static_assert((endpoint.bmAttributes.get() & static_cast<uint8_t>(usb2::UsageType_t::__mask)) ==
+        static_cast<uint8_t>(usb2::UsageType_t::Feedback_endpoint), "Endpoint is not a feedback endpoint");
+    static_assert(endpoint.wMaxPacketSize.size() >= size, "wMaxPacketSize is too small for Ff");
+    static_assert(binterval >= 1 && binterval - 1 + Resolution <= fraction_bits,
+        "bInterval or Resolution is out of range");
+    static_assert(Filter < 32 && Gain <= fraction_bits, "Filter or Gain is out of range");
+
+    explicit constexpr generator(uint32_t nominal)
+      : filtered(static_cast<uint64_t>(nominal) << Filter), correction(0), last(0), frames(0),
+        started(false), encoded{} {
+        encode(nominal);
+    }
+
+    // Called at each SOF with the free running count of ticks of the
+    // sample clock of the device. Returns true when Ff is updated
+    constexpr bool sof(uint32_t ticks) {
+        if( ! started ) {
+            started = true;
+            last = ticks;
+            return false;
+        }
+        if( ++frames < period ) return false;
+        frames = 0;
+        const uint32_t measured = (ticks - last) << (fraction_bits - (binterval - 1) - Resolution);
+        last = ticks;
+        filtered -= filtered >> Filter;
+        filtered += measured;
+        encode(value());
+        return true;
+    }
+
+    // Reports the level of the OUT endpoint buffer as samples above the
+    // target level, negative if below. Applies at the next update
+    constexpr void occupancy(int32_t above_target) {
+        correction = above_target * (int32_t(1) << (fraction_bits - Gain));
+    }
+
+    // Samples per (micro)frame of the device clock, filtered
+    constexpr uint32_t rate() const { return static_cast<uint32_t>(filtered >> Filter); }
+
+    // Current Ff, the rate, corrected by the buffer level
+    constexpr uint32_t value() const {
+        const int64_t result = static_cast<int64_t>(rate()) - correction;
+        return result < 0 ? 0 : static_cast<uint32_t>(result);
+    }
+
+    // Ff, encoded little endian in size bytes
+    constexpr const uint8_t* data() const { return encoded; }
+
+private:
+    constexpr void encode(uint32_t v) {
+        for(unsigned i = 0; i < size; ++i)
+            encoded[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+    uint64_t filtered;
+    int32_t correction;
+    uint32_t last;
+    unsigned frames;
+    bool started;
+    uint8_t encoded[size];
+};
+
+} // namespace feedback
+} // namespace usbplusplus
@@ -43,6 +43,16 @@ enum class HidInterfaceProtocol_t : uint8_t {
 	MOUSE						= 0x01,
 };
 
+/* 7.2 Class-Specific Requests */
+enum class HidRequestCode_t : uint8_t {
+	GET_REPORT					= 0x01,
+	GET_IDLE					= 0x02,
+	GET_PROTOCOL				= 0x03,
+	SET_REPORT					= 0x09,
+	SET_IDLE					= 0x0A,
+	SET_PROTOCOL				= 0x0B,
+};
+
 using HidInterfaceClassCode = detail::constant<ClassCode_t, ClassCode_t::HID>;
 using HidInterfaceSubclassCode = HidInterfaceSubclassCode_t;
 using HidInterfaceProtocol	= HidInterfaceProtocol_t;
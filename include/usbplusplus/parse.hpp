@@ -0,0 +1,258 @@
+/* Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * parse.hpp - Host side, non-allocating parser of configuration descriptors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+#include <usbplusplus/usbplusplus.hpp>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#if __cplusplus < 202002L
+#error "Descriptor parser requires c++20 or higher"
+#endif
+
+namespace usbplusplus {
+namespace parse {
+
+using bytes = std::span<const uint8_t>;
+
+// Reason a configuration blob is not valid
+enum class error_t : uint8_t {
+    none,
+    truncated,          // the blob is shorter than the configuration descriptor or than its wTotalLength
+    not_configuration,  // the first descriptor is neither CONFIGURATION nor OTHER_SPEED
+    bad_total_length,   // wTotalLength is less than the configuration descriptor's bLength
+    bad_length,         // a bLength is less than 2 or the descriptor runs past wTotalLength
+};
+
+namespace detail {
+// Shortest bLength of a descriptor, viewed as Descriptor
+template<typename Descriptor>
+constexpr unsigned min_length() {
+    if constexpr (requires { Descriptor::length(); })
+        return Descriptor::length();
+    else
+        return sizeof(Descriptor);
+}
+
+// Whether data starts with a descriptor that fits in data
+constexpr bool well_formed(bytes data) {
+    return data.size() >= 2 && data[0] >= 2 && data[0] <= data.size();
+}
+
+// wTotalLength of a configuration descriptor
+constexpr uint16_t total_length(bytes data) {
+    return static_cast<uint16_t>(data[2] | data[3] << 8);
+}
+} // namespace detail
+
+// Descriptor of type Descriptor, one of the USB++ structs, residing in a blob.
+// Access via -> is zero-copy, value() makes a copy and is usable in constant expressions.
+// Members, laid past the bLength bytes, such as endpoints of an Interface, are not part of the view
+template<typename Descriptor>
+class view {
+public:
+    constexpr explicit view(bytes data) : data_{data} {}
+    constexpr Descriptor value() const {
+        std::array<uint8_t, sizeof(Descriptor)> copy {};
+        for (std::size_t i = 0; i < copy.size() && i < data_.size(); ++i)
+            copy[i] = data_[i];
+        return std::bit_cast<Descriptor>(copy);
+    }
+    const Descriptor* operator->() const { return reinterpret_cast<const Descriptor*>(data_.data()); }
+    const Descriptor& operator*() const { return *operator->(); }
+    constexpr bytes data() const { return data_; }
+private:
+    bytes data_;
+};
+
+// Class and subclass codes of the interface a class-specific descriptor belongs to.
+// Class-specific subtypes overlap across classes and subclasses, e.g. AS_GENERAL and HEADER are both 1
+struct interface_context {
+    uint8_t interface_class;
+    uint8_t interface_subclass;
+};
+
+// One descriptor in a chain
+class descriptor {
+public:
+    constexpr explicit descriptor(bytes data, interface_context context = {}) : data_{data}, context_{context} {}
+    constexpr uint8_t length() const { return data_[0]; }
+    constexpr uint8_t type() const { return data_[1]; }
+    // bDescriptorSubType of a class-specific descriptor, or 0 if the descriptor is too short to have one
+    constexpr uint8_t subtype() const { return data_.size() > 2 ? data_[2] : 0; }
+    constexpr interface_context context() const { return context_; }
+    constexpr bytes data() const { return data_; }
+
+    // Whether the descriptor has type, subtype and, at least, the length of Descriptor.
+    // When the subtype of Descriptor declares interfaceclass() and interfacesubclass(), they must match
+    // the context, unless the descriptor precedes any interface, as in a chain over a fragment
+    template<typename Descriptor>
+    constexpr bool is() const {
+        if (type() != static_cast<uint8_t>(Descriptor::descriptortype()) || length() < detail::min_length<Descriptor>())
+            return false;
+        if constexpr (requires { Descriptor::descriptorsubtype(); })
+            return subtype() == static_cast<uint8_t>(Descriptor::descriptorsubtype()) &&
+                   in_context(Descriptor::descriptorsubtype());
+        else
+            return true;
+    }
+    // View of the descriptor as Descriptor, is<Descriptor>() must be true
+    template<typename Descriptor>
+    constexpr view<Descriptor> as() const { return view<Descriptor>{data_}; }
+private:
+    template<typename Subtype>
+    constexpr bool in_context(Subtype subtype) const {
+        if (context_.interface_class == 0) return true;
+        if constexpr (requires { interfaceclass(subtype); })
+            if (context_.interface_class != static_cast<uint8_t>(interfaceclass(subtype))) return false;
+        if constexpr (requires { interfacesubclass(subtype); })
+            if (context_.interface_subclass != static_cast<uint8_t>(interfacesubclass(subtype))) return false;
+        return true;
+    }
+    bytes data_;
+    interface_context context_;
+};
+
+// Forward iterator over a chain of descriptors, linked by bLength.
+// Iteration ends at the end of data or at the first malformed descriptor
+class iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = descriptor;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+    constexpr explicit iterator(bytes data) : rest_{detail::well_formed(data) ? data : bytes{}}, context_{} {
+        enter();
+    }
+    constexpr descriptor operator*() const { return descriptor{rest_.first(rest_[0]), context_}; }
+    constexpr iterator& operator++() {
+        const auto next = rest_.subspan(rest_[0]);
+        rest_ = detail::well_formed(next) ? next : bytes{};
+        enter();
+        return *this;
+    }
+    constexpr iterator operator++(int) {
+        auto prev = *this;
+        ++*this;
+        return prev;
+    }
+    constexpr bool operator==(const iterator& that) const {
+        return rest_.size() == that.rest_.size() && (rest_.empty() || rest_.data() == that.rest_.data());
+    }
+private:
+    // Updates the context when the current descriptor is an interface
+    constexpr void enter() {
+        if (rest_.size() >= 7 && rest_[1] == static_cast<uint8_t>(DescriptorType_t::INTERFACE))
+            context_ = { rest_[5], rest_[6] };
+    }
+    bytes rest_ {};
+    interface_context context_ {};
+};
+
+// Chain of descriptors, such as a configuration or a part of it
+class chain {
+public:
+    constexpr explicit chain(bytes data) : data_{data} {}
+    constexpr iterator begin() const { return iterator{data_}; }
+    constexpr iterator end() const { return iterator{}; }
+    constexpr bytes data() const { return data_; }
+
+    // Number of descriptors of the type
+    constexpr std::size_t count(DescriptorType_t type) const {
+        std::size_t result = 0;
+        for (auto item : *this)
+            result += item.type() == static_cast<uint8_t>(type);
+        return result;
+    }
+    // Number of descriptors, matching Descriptor
+    template<typename Descriptor>
+    constexpr std::size_t count() const {
+        std::size_t result = 0;
+        for (auto item : *this)
+            result += item.is<Descriptor>();
+        return result;
+    }
+    // Calls f with the view of each descriptor, matching Descriptor, in order of appearance
+    template<typename Descriptor, typename F>
+    constexpr void each(F&& f) const {
+        for (auto item : *this)
+            if (item.is<Descriptor>()) f(item.as<Descriptor>());
+    }
+private:
+    bytes data_;
+};
+
+// Checks the configuration descriptor at the start of the blob and its wTotalLength
+constexpr error_t validate_header(bytes blob) {
+    if (blob.size() < sizeof(usb2::Configuration<Empty>)) return error_t::truncated;
+    if (blob[1] != static_cast<uint8_t>(DescriptorType_t::CONFIGURATION) &&
+        blob[1] != static_cast<uint8_t>(DescriptorType_t::OTHER_SPEED))
+        return error_t::not_configuration;
+    if (blob[0] < sizeof(usb2::Configuration<Empty>)) return error_t::bad_length;
+    const std::size_t total = detail::total_length(blob);
+    if (total < blob[0]) return error_t::bad_total_length;
+    if (total > blob.size()) return error_t::truncated;
+    return error_t::none;
+}
+
+// Checks the configuration blob: its header, wTotalLength and the chain of descriptors
+constexpr error_t validate(bytes blob) {
+    if (const auto error = validate_header(blob); error != error_t::none) return error;
+    const std::size_t total = detail::total_length(blob);
+    std::size_t pos = 0;
+    while (pos < total) {
+        if (!detail::well_formed(blob.subspan(pos, total - pos))) return error_t::bad_length;
+        pos += blob[pos];
+    }
+    return error_t::none;
+}
+
+// Configuration blob, as returned by GET_DESCRIPTOR(CONFIGURATION), possibly followed by other data.
+// A blob that is not valid() has no descriptors
+class configuration : public chain {
+public:
+    constexpr explicit configuration(bytes blob) : configuration{blob, validate(blob)} {}
+    constexpr error_t error() const { return error_; }
+    constexpr bool valid() const { return error_ == error_t::none; }
+    constexpr uint16_t totallength() const { return static_cast<uint16_t>(data().size()); }
+    constexpr uint8_t numinterfaces() const { return valid() ? data()[4] : 0; }
+    constexpr uint8_t configurationvalue() const { return valid() ? data()[5] : 0; }
+private:
+    constexpr configuration(bytes blob, error_t error)
+      : chain{error == error_t::none ? blob.first(detail::total_length(blob)) : bytes{}}, error_{error} {}
+    error_t error_;
+};
+
+// Bytes of a USB++ descriptor, for parsing it in constant expressions
+template<typename Descriptor>
+constexpr std::array<uint8_t, sizeof(Descriptor)> bytes_of(const Descriptor& descriptor) {
+    return std::bit_cast<std::array<uint8_t, sizeof(Descriptor)>>(descriptor);
+}
+
+} // namespace parse
+} // namespace usbplusplus
@@ -0,0 +1,518 @@
+/* Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * pcm.hpp - PCM sample format converters, matched to Type I Format Type descriptors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+#include <usbplusplus/usbplusplus.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#if __cplusplus < 201703L
+#error "PCM converters require c++17 or higher"
+#endif
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * Frmts20 final.pdf, 2.3.1.2 Subslot, Frmts10.pdf, 2.2.2 Audio Subframe.
+ * A sample is MSB-justified in its 2, 3 or 4 byte little endian subslot,
+ * bits below bBitResolution are zero. Samples of a frame are interleaved.
+ * On the DSP side samples are planar, either int32, MSB-justified, or float
+ * in [-1, 1).
+ */
+
+namespace usbplusplus {
+namespace pcm {
+
+// Scalar kernels, for any target and for the tails of vector kernels
+struct scalar {
+    static constexpr const char* isa = "scalar";
+
+    // Subslots to MSB-justified int32, bits below the resolution cleared by mask
+    template<unsigned Subslot>
+    static void unpack(const uint8_t* in, int32_t* out, std::size_t count, uint32_t mask) {
+        for(std::size_t i = 0; i < count; ++i, in += Subslot) {
+            uint32_t sample = 0;
+            for(unsigned b = 0; b < Subslot; ++b)
+                sample |= static_cast<uint32_t>(in[b]) << (8 * (4 - Subslot + b));
+            out[i] = static_cast<int32_t>(sample & mask);
+        }
+    }
+
+    // MSB-justified int32 to subslots, truncated to the resolution
+    template<unsigned Subslot>
+    static void pack(const int32_t* in, uint8_t* out, std::size_t count, uint32_t mask) {
+        for(std::size_t i = 0; i < count; ++i, out += Subslot) {
+            const uint32_t sample = static_cast<uint32_t>(in[i]) & mask;
+            for(unsigned b = 0; b < Subslot; ++b)
+                out[b] = static_cast<uint8_t>(sample >> (8 * (4 - Subslot + b)));
+        }
+    }
+
+    static constexpr float to_float_scale = 1.0f / 2147483648.0f;
+    static constexpr float from_float_scale = 2147483648.0f;
+    // The largest float below 2^31, converts to int32 without overflow
+    static constexpr float from_float_max = 2147483520.0f;
+
+    static void to_float(const int32_t* in, float* out, std::size_t count) {
+        for(std::size_t i = 0; i < count; ++i)
+            out[i] = static_cast<float>(in[i]) * to_float_scale;
+    }
+
+    // Saturates at full scale, truncates toward zero
+    static void from_float(const float* in, int32_t* out, std::size_t count) {
+        for(std::size_t i = 0; i < count; ++i) {
+            float sample = in[i] * from_float_scale;
+            sample = sample < from_float_max ? sample : from_float_max;
+            sample = sample > -from_float_scale ? sample : -from_float_scale;
+            out[i] = static_cast<int32_t>(sample);
+        }
+    }
+};
+
+#if defined(__SSE2__)
+// SSE2 kernels, SSSE3 for 3 byte subslots
+struct sse {
+    static constexpr const char* isa = "SSE";
+
+    template<unsigned Subslot>
+    static void unpack(const uint8_t* in, int32_t* out, std::size_t count, uint32_t mask) {
+        const __m128i bits = _mm_set1_epi32(static_cast<int>(mask));
+        std::size_t i = 0;
+        if constexpr( Subslot == 2 ) {
+            const __m128i zero = _mm_setzero_si128();
+            for(; i + 8 <= count; i += 8) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_and_si128(_mm_unpacklo_epi16(zero, x), bits));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_and_si128(_mm_unpackhi_epi16(zero, x), bits));
+            }
+        }
+#if defined(__SSSE3__)
+        if constexpr( Subslot == 3 ) {
+            const __m128i shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+            /* loads 16 bytes for 12 */
+            for(; i + 6 <= count; i += 4) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 3 * i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_and_si128(_mm_shuffle_epi8(x, shuffle), bits));
+            }
+        }
+#endif
+        if constexpr( Subslot == 4 ) {
+            for(; i + 4 <= count; i += 4) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4 * i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_and_si128(x, bits));
+            }
+        }
+        scalar::unpack<Subslot>(in + Subslot * i, out + i, count - i, mask);
+    }
+
+    template<unsigned Subslot>
+    static void pack(const int32_t* in, uint8_t* out, std::size_t count, uint32_t mask) {
+        const __m128i bits = _mm_set1_epi32(static_cast<int>(mask));
+        std::size_t i = 0;
+        if constexpr( Subslot == 2 ) {
+            for(; i + 8 <= count; i += 8) {
+                const __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), bits);
+                const __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 4)), bits);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i),
+                    _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)));
+            }
+        }
+#if defined(__SSSE3__)
+        if constexpr( Subslot == 3 ) {
+            const __m128i shuffle = _mm_setr_epi8(1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1);
+            /* stores 16 bytes for 12, the next store overwrites the extra 4 */
+            for(; i + 6 <= count; i += 4) {
+                const __m128i x = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), bits);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 3 * i), _mm_shuffle_epi8(x, shuffle));
+            }
+        }
+#endif
+        if constexpr( Subslot == 4 ) {
+            for(; i + 4 <= count; i += 4) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * i), _mm_and_si128(x, bits));
+            }
+        }
+        scalar::pack<Subslot>(in + i, out + Subslot * i, count - i, mask);
+    }
+
+    static void to_float(const int32_t* in, float* out, std::size_t count) {
+        const __m128 scale = _mm_set1_ps(scalar::to_float_scale);
+        std::size_t i = 0;
+        for(; i + 4 <= count; i += 4) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(x), scale));
+        }
+        scalar::to_float(in + i, out + i, count - i);
+    }
+
+    static void from_float(const float* in, int32_t* out, std::size_t count) {
+        const __m128 scale = _mm_set1_ps(scalar::from_float_scale);
+        const __m128 high = _mm_set1_ps(scalar::from_float_max);
+        const __m128 low = _mm_set1_ps(-scalar::from_float_scale);
+        std::size_t i = 0;
+        for(; i + 4 <= count; i += 4) {
+            const __m128 x = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(in + i), scale), high), low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_cvttps_epi32(x));
+        }
+        scalar::from_float(in + i, out + i, count - i);
+    }
+};
+#endif
+
+#if defined(__AVX2__)
+struct avx2 {
+    static constexpr const char* isa = "AVX2";
+
+    template<unsigned Subslot>
+    static void unpack(const uint8_t* in, int32_t* out, std::size_t count, uint32_t mask) {
+        const __m256i bits = _mm256_set1_epi32(static_cast<int>(mask));
+        std::size_t i = 0;
+        if constexpr( Subslot == 2 ) {
+            for(; i + 8 <= count; i += 8) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i));
+                const __m256i wide = _mm256_slli_epi32(_mm256_cvtepi16_epi32(x), 16);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(wide, bits));
+            }
+        }
+        if constexpr( Subslot == 3 ) {
+            const __m256i shuffle = _mm256_setr_epi8(
+                -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+                -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+            /* two loads of 16 bytes for 24, 12 bytes apart */
+            for(; i + 10 <= count; i += 8) {
+                const uint8_t* p = in + 3 * i;
+                const __m256i x = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12)), 1);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(_mm256_shuffle_epi8(x, shuffle), bits));
+            }
+        }
+        if constexpr( Subslot == 4 ) {
+            for(; i + 8 <= count; i += 8) {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 4 * i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(x, bits));
+            }
+        }
+        scalar::unpack<Subslot>(in + Subslot * i, out + i, count - i, mask);
+    }
+
+    template<unsigned Subslot>
+    static void pack(const int32_t* in, uint8_t* out, std::size_t count, uint32_t mask) {
+        const __m256i bits = _mm256_set1_epi32(static_cast<int>(mask));
+        std::size_t i = 0;
+        if constexpr( Subslot == 2 ) {
+            for(; i + 16 <= count; i += 16) {
+                const __m256i a = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), bits);
+                const __m256i b = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 8)), bits);
+                /* packs works within 128 bit lanes, permute restores the order */
+                const __m256i x = _mm256_packs_epi32(_mm256_srai_epi32(a, 16), _mm256_srai_epi32(b, 16));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute4x64_epi64(x, 0b11011000));
+            }
+        }
+        if constexpr( Subslot == 3 ) {
+            const __m256i shuffle = _mm256_setr_epi8(
+                1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1,
+                1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1);
+            /* two stores of 16 bytes for 24, the upper one overwrites the extra 4 */
+            for(; i + 10 <= count; i += 8) {
+                const __m256i x = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), bits);
+                const __m256i y = _mm256_shuffle_epi8(x, shuffle);
+                uint8_t* p = out + 3 * i;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(y));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 12), _mm256_extracti128_si256(y, 1));
+            }
+        }
+        if constexpr( Subslot == 4 ) {
+            for(; i + 8 <= count; i += 8) {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4 * i), _mm256_and_si256(x, bits));
+            }
+        }
+        scalar::pack<Subslot>(in + i, out + Subslot * i, count - i, mask);
+    }
+
+    static void to_float(const int32_t* in, float* out, std::size_t count) {
+        const __m256 scale = _mm256_set1_ps(scalar::to_float_scale);
+        std::size_t i = 0;
+        for(; i + 8 <= count; i += 8) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(x), scale));
+        }
+        scalar::to_float(in + i, out + i, count - i);
+    }
+
+    static void from_float(const float* in, int32_t* out, std::size_t count) {
+        const __m256 scale = _mm256_set1_ps(scalar::from_float_scale);
+        const __m256 high = _mm256_set1_ps(scalar::from_float_max);
+        const __m256 low = _mm256_set1_ps(-scalar::from_float_scale);
+        std::size_t i = 0;
+        for(; i + 8 <= count; i += 8) {
+            const __m256 x = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), high), low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_cvttps_epi32(x));
+        }
+        scalar::from_float(in + i, out + i, count - i);
+    }
+};
+#endif
+
+#if defined(__ARM_NEON)
+struct neon {
+    static constexpr const char* isa = "NEON";
+
+    template<unsigned Subslot>
+    static void unpack(const uint8_t* in, int32_t* out, std::size_t count, uint32_t mask) {
+        const uint32x4_t bits = vdupq_n_u32(mask);
+        std::size_t i = 0;
+        if constexpr( Subslot == 2 ) {
+            for(; i + 8 <= count; i += 8) {
+                const int16x8_t x = vreinterpretq_s16_u8(vld1q_u8(in + 2 * i));
+                const uint32x4_t lo = vreinterpretq_u32_s32(vshll_n_s16(vget_low_s16(x), 16));
+                const uint32x4_t hi = vreinterpretq_u32_s32(vshll_n_s16(vget_high_s16(x), 16));
+                vst1q_s32(out + i, vreinterpretq_s32_u32(vandq_u32(lo, bits)));
+                vst1q_s32(out + i + 4, vreinterpretq_s32_u32(vandq_u32(hi, bits)));
+            }
+        }
+        if constexpr( Subslot == 3 ) {
+            for(; i + 8 <= count; i += 8) {
+                const uint8x8x3_t x = vld3_u8(in + 3 * i);
+                /* b1 << 8 | b0 and b2, widened and shifted in place */
+                const uint16x8_t low = vorrq_u16(vmovl_u8(x.val[0]), vshll_n_u8(x.val[1], 8));
+                const uint16x8_t high = vmovl_u8(x.val[2]);
+                const uint32x4_t a = vorrq_u32(vshll_n_u16(vget_low_u16(low), 8),
+                    vshlq_n_u32(vmovl_u16(vget_low_u16(high)), 24));
+                const uint32x4_t b = vorrq_u32(vshll_n_u16(vget_high_u16(low), 8),
+                    vshlq_n_u32(vmovl_u16(vget_high_u16(high)), 24));
+                vst1q_s32(out + i, vreinterpretq_s32_u32(vandq_u32(a, bits)));
+                vst1q_s32(out + i + 4, vreinterpretq_s32_u32(vandq_u32(b, bits)));
+            }
+        }
+        if constexpr( Subslot == 4 ) {
+            for(; i + 4 <= count; i += 4) {
+                const uint32x4_t x = vreinterpretq_u32_u8(vld1q_u8(in + 4 * i));
+                vst1q_s32(out + i, vreinterpretq_s32_u32(vandq_u32(x, bits)));
+            }
+        }
+        scalar::unpack<Subslot>(in + Subslot * i, out + i, count - i, mask);
+    }
+
+    template<unsigned Subslot>
+    static void pack(const int32_t* in, uint8_t* out, std::size_t count, uint32_t mask) {
+        const uint32x4_t bits = vdupq_n_u32(mask);
+        std::size_t i = 0;
+        if constexpr( Subslot == 2 ) {
+            for(; i + 8 <= count; i += 8) {
+                const int32x4_t a = vreinterpretq_s32_u32(vandq_u32(vreinterpretq_u32_s32(vld1q_s32(in + i)), bits));
+                const int32x4_t b = vreinterpretq_s32_u32(vandq_u32(vreinterpretq_u32_s32(vld1q_s32(in + i + 4)), bits));
+                const int16x8_t x = vcombine_s16(vshrn_n_s32(a, 16), vshrn_n_s32(b, 16));
+                vst1q_u8(out + 2 * i, vreinterpretq_u8_s16(x));
+            }
+        }
+        if constexpr( Subslot == 3 ) {
+            for(; i + 8 <= count; i += 8) {
+                const uint32x4_t a = vandq_u32(vreinterpretq_u32_s32(vld1q_s32(in + i)), bits);
+                const uint32x4_t b = vandq_u32(vreinterpretq_u32_s32(vld1q_s32(in + i + 4)), bits);
+                /* bytes 1 and 2, and byte 3 of each sample */
+                const uint16x8_t middle = vcombine_u16(vshrn_n_u32(a, 8), vshrn_n_u32(b, 8));
+                const uint16x8_t top = vcombine_u16(vshrn_n_u32(a, 16), vshrn_n_u32(b, 16));
+                uint8x8x3_t x;
+                x.val[0] = vmovn_u16(middle);
+                x.val[1] = vshrn_n_u16(middle, 8);
+                x.val[2] = vshrn_n_u16(top, 8);
+                vst3_u8(out + 3 * i, x);
+            }
+        }
+        if constexpr( Subslot == 4 ) {
+            for(; i + 4 <= count; i += 4) {
+                const uint32x4_t x = vandq_u32(vreinterpretq_u32_s32(vld1q_s32(in + i)), bits);
+                vst1q_u8(out + 4 * i, vreinterpretq_u8_u32(x));
+            }
+        }
+        scalar::pack<Subslot>(in + i, out + Subslot * i, count - i, mask);
+    }
+
+    static void to_float(const int32_t* in, float* out, std::size_t count) {
+        std::size_t i = 0;
+        for(; i + 4 <= count; i += 4)
+            vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(in + i)), scalar::to_float_scale));
+        scalar::to_float(in + i, out + i, count - i);
+    }
+
+    static void from_float(const float* in, int32_t* out, std::size_t count) {
+        const float32x4_t high = vdupq_n_f32(scalar::from_float_max);
+        const float32x4_t low = vdupq_n_f32(-scalar::from_float_scale);
+        std::size_t i = 0;
+        for(; i + 4 <= count; i += 4) {
+            const float32x4_t x = vmulq_n_f32(vld1q_f32(in + i), scalar::from_float_scale);
+            vst1q_s32(out + i, vcvtq_s32_f32(vmaxq_f32(vminq_f32(x, high), low)));
+        }
+        scalar::from_float(in + i, out + i, count - i);
+    }
+};
+#endif
+
+// Kernel set of the widest instruction set, enabled for the target
+#if defined(__AVX2__)
+using native = avx2;
+#elif defined(__SSE2__)
+using native = sse;
+#elif defined(__ARM_NEON)
+using native = neon;
+#else
+using native = scalar;
+#endif
+
+namespace detail {
+template<typename Format, typename = void>
+struct has_subslot : std::false_type {};
+
+template<typename Format>
+struct has_subslot<Format, std::void_t<decltype(std::declval<const Format&>().bSubslotSize)>> : std::true_type {};
+
+template<typename Format, typename = void>
+struct has_channels : std::false_type {};
+
+template<typename Format>
+struct has_channels<Format, std::void_t<decltype(std::declval<const Format&>().bNrChannels)>> : std::true_type {};
+
+// bSubslotSize of UAC2 or bSubframeSize of UAC1 Type I Format Type
+template<typename Format>
+constexpr unsigned subslot_of(const Format& format) {
+    if constexpr (has_subslot<Format>::value)
+        return format.bSubslotSize.get();
+    else
+        return format.bSubframeSize.get();
+}
+
+// bNrChannels of UAC1 Type I Format Type, zero for UAC2 that has no such field
+template<typename Format>
+constexpr unsigned channels_of(const Format& format) {
+    if constexpr (has_channels<Format>::value)
+        return format.bNrChannels.get();
+    else
+        return 0;
+}
+} // namespace detail
+
+// Converts packets of interleaved subslots to and from planar buffers.
+// The subslot size and the resolution are taken from the Type I Format
+// Type descriptor, UAC1 or UAC2, so the data path follows the descriptor.
+// Channels defaults to bNrChannels of UAC1, UAC2 requires it explicitly.
+// Kernels is one of the kernel sets, by default the widest enabled at compile time.
+// Usage:
+//   using MyConverter = pcm::converter<myFormat, 2>;
+//   MyConverter::to_planar(packet, frames, planes);
+template<const auto& Format, unsigned Channels = detail::channels_of(Format), typename Kernels = native>
+class converter {
+    // Frames converted at once through the interleaved buffers on the stack
+    static constexpr unsigned block = Channels < 256 ? 256 / Channels : 1;
+public:
+    static constexpr unsigned subslot = detail::subslot_of(Format);
+    static constexpr unsigned bits = Format.bBitResolution.get();
+    static constexpr unsigned channels = Channels;
+    static constexpr unsigned frame_size = subslot * Channels;
+    // Clears bits below the resolution
+    static constexpr uint32_t mask = bits >= 32 ? ~0u : ~(~0u >> bits);
+    static_assert(subslot >= 2 && subslot <= 4, "Subslot size must be 2, 3 or 4");
+    static_assert(bits > 0 && bits <= 8 * subslot, "Bit resolution does not fit the subslot");
+    static_assert(Channels > 0, "Channel count is required");
+
+    // Interleaved subslots of frames to planar MSB-justified int32
+    static void to_planar(const uint8_t* packet, std::size_t frames, int32_t* const planes[Channels]) {
+        if constexpr (Channels == 1) {
+            Kernels::template unpack<subslot>(packet, planes[0], frames, mask);
+        } else {
+            int32_t samples[block * Channels];
+            for(std::size_t done = 0; done < frames; done += block) {
+                const std::size_t count = frames - done < block ? frames - done : block;
+                Kernels::template unpack<subslot>(packet + done * frame_size, samples, count * Channels, mask);
+                deinterleave(samples, count, planes, done);
+            }
+        }
+    }
+    // Interleaved subslots of frames to planar float
+    static void to_planar(const uint8_t* packet, std::size_t frames, float* const planes[Channels]) {
+        int32_t samples[block * Channels];
+        float values[block * Channels];
+        for(std::size_t done = 0; done < frames; done += block) {
+            const std::size_t count = frames - done < block ? frames - done : block;
+            Kernels::template unpack<subslot>(packet + done * frame_size, samples, count * Channels, mask);
+            if constexpr (Channels == 1) {
+                Kernels::to_float(samples, planes[0] + done, count);
+            } else {
+                Kernels::to_float(samples, values, count * Channels);
+                deinterleave(values, count, planes, done);
+            }
+        }
+    }
+    // Planar MSB-justified int32 to interleaved subslots of frames
+    static void from_planar(const int32_t* const planes[Channels], std::size_t frames, uint8_t* packet) {
+        if constexpr (Channels == 1) {
+            Kernels::template pack<subslot>(planes[0], packet, frames, mask);
+        } else {
+            int32_t samples[block * Channels];
+            for(std::size_t done = 0; done < frames; done += block) {
+                const std::size_t count = frames - done < block ? frames - done : block;
+                interleave(planes, done, count, samples);
+                Kernels::template pack<subslot>(samples, packet + done * frame_size, count * Channels, mask);
+            }
+        }
+    }
+    // Planar float to interleaved subslots of frames
+    static void from_planar(const float* const planes[Channels], std::size_t frames, uint8_t* packet) {
+        int32_t samples[block * Channels];
+        float values[block * Channels];
+        for(std::size_t done = 0; done < frames; done += block) {
+            const std::size_t count = frames - done < block ? frames - done : block;
+            if constexpr (Channels == 1) {
+                Kernels::from_float(planes[0] + done, samples, count);
+            } else {
+                interleave(planes, done, count, values);
+                Kernels::from_float(values, samples, count * Channels);
+            }
+            Kernels::template pack<subslot>(samples, packet + done * frame_size, count * Channels, mask);
+        }
+    }
+private:
+    template<typename T>
+    static void deinterleave(const T* samples, std::size_t count, T* const planes[Channels], std::size_t done) {
+        for(unsigned c = 0; c < Channels; ++c)
+            for(std::size_t f = 0; f < count; ++f)
+                planes[c][done + f] = samples[f * Channels + c];
+    }
+    template<typename T>
+    static void interleave(const T* const planes[Channels], std::size_t done, std::size_t count, T* samples) {
+        for(unsigned c = 0; c < Channels; ++c)
+            for(std::size_t f = 0; f < count; ++f)
+                samples[f * Channels + c] = planes[c][done + f];
+    }
+};
+
+} // namespace pcm
+} // namespace usbplusplus
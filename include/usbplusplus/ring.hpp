@@ -0,0 +1,163 @@
+/* Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * ring.hpp - Lock-free ring of isochronous audio packets
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+#include <usbplusplus/usbplusplus.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#if __cplusplus < 201703L
+#error "Audio packet ring requires c++17 or higher"
+#endif
+
+namespace usbplusplus {
+namespace ring {
+
+// Assumed size of a cache line, indices of the producer and the consumer,
+// and packets, do not share one
+constexpr std::size_t cache_line = 64;
+
+// Audio, a ring holds by default, the consumer may be late by about a half of it
+constexpr unsigned default_depth_us = 8000;
+
+// Packets for depth_us of audio at Schedule, a power of two, at least two
+template<typename Schedule>
+constexpr unsigned packets_for(unsigned depth_us = default_depth_us) {
+    unsigned packets = 2;
+    while( packets * Schedule::interval_us < depth_us ) packets *= 2;
+    return packets;
+}
+
+// Bytes of one isochronous packet in the ring
+struct packet {
+    uint8_t* data;
+    unsigned size;
+    constexpr bool empty() const { return data == nullptr; }
+};
+
+// Single producer, single consumer ring of whole isochronous packets,
+// passed between the USB interrupt and the audio thread without copying.
+// Schedule is a uac2::PacketSchedule, it gives the largest packet and the
+// frame size, computed from the format and the endpoint descriptors.
+// Either side may read the level in frames, e.g. to report it to
+// feedback::generator::occupancy. For an IN endpoint the audio thread is
+// the producer and commits packets of Schedule::next_bytes().
+// Packets default to default_depth_us of audio, 8 at full speed and 64 at
+// high speed with bInterval 1
+// Usage:
+//   ring::spsc<MySchedule> buffer;
+//   // OUT endpoint interrupt, producer
+//   packet p = buffer.reserve(); ... buffer.commit(received);
+//   // audio thread, consumer
+//   packet p = buffer.front(); ... buffer.release();
+template<typename Schedule, unsigned Packets = packets_for<Schedule>()>
+class spsc {
+public:
+    static constexpr unsigned capacity = Packets;
+    static constexpr unsigned frame_size = Schedule::frame_size;
+    // Bytes available to a packet, enough for the largest one
+    static constexpr unsigned packet_size = Schedule::max_bytes;
+    static constexpr std::size_t stride = (packet_size + cache_line - 1) / cache_line * cache_line;
+    static_assert(Packets >= 2 && (Packets & (Packets - 1)) == 0, "Packets must be a power of two");
+
+    // Producer: space for the next packet, empty if the ring is full
+    packet reserve() {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        if( h - cached_tail == Packets ) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if( h - cached_tail == Packets ) {
+                overrun_count.store(overrun_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return { nullptr, 0 };
+            }
+        }
+        return { storage[h % Packets], packet_size };
+    }
+
+    // Producer: publishes size bytes of the reserved packet, whole frames
+    void commit(unsigned size) {
+        assert(size <= packet_size && size % frame_size == 0);
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        sizes[h % Packets] = size;
+        produced.store(produced.load(std::memory_order_relaxed) + size / frame_size, std::memory_order_release);
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // Consumer: the oldest committed packet, empty if there is none
+    packet front() {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        if( t == cached_head ) {
+            cached_head = head.load(std::memory_order_acquire);
+            if( t == cached_head ) {
+                underrun_count.store(underrun_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return { nullptr, 0 };
+            }
+        }
+        return { storage[t % Packets], sizes[t % Packets] };
+    }
+
+    // Consumer: returns the packet, obtained with front, to the producer
+    void release() {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        consumed.store(consumed.load(std::memory_order_relaxed) + sizes[t % Packets] / frame_size, std::memory_order_release);
+        tail.store(t + 1, std::memory_order_release);
+    }
+
+    // Committed packets, not yet released
+    unsigned packets() const {
+        const uint32_t t = tail.load(std::memory_order_acquire);
+        return head.load(std::memory_order_acquire) - t;
+    }
+
+    // Committed frames, not yet released
+    uint32_t frames() const {
+        const uint32_t r = consumed.load(std::memory_order_acquire);
+        return produced.load(std::memory_order_acquire) - r;
+    }
+
+    // Calls of reserve on a full ring
+    uint32_t overruns() const { return overrun_count.load(std::memory_order_relaxed); }
+
+    // Calls of front on an empty ring
+    uint32_t underruns() const { return underrun_count.load(std::memory_order_relaxed); }
+
+private:
+    /* producer */
+    alignas(cache_line) std::atomic<uint32_t> head { 0 };
+    std::atomic<uint32_t> produced { 0 };
+    std::atomic<uint32_t> overrun_count { 0 };
+    uint32_t cached_tail = 0;
+    /* consumer */
+    alignas(cache_line) std::atomic<uint32_t> tail { 0 };
+    std::atomic<uint32_t> consumed { 0 };
+    std::atomic<uint32_t> underrun_count { 0 };
+    uint32_t cached_head = 0;
+    /* shared, one writer at a time */
+    alignas(cache_line) unsigned sizes[Packets] {};
+    alignas(cache_line) uint8_t storage[Packets][stride];
+};
+
+} // namespace ring
+} // namespace usbplusplus
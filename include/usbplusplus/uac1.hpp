@@ -109,6 +109,16 @@ enum class ASInterfaceDescriptorSubtype_t : uint8_t {
 	FORMAT_SPECIFIC				= 0x03,
 };
 
+/* Interface class and subclass, class-specific descriptors of a subtype belong to */
+constexpr ClassCode_t interfaceclass(ACInterfaceDescriptorSubtype_t) { return ClassCode_t::Audio; }
+constexpr AudioInterfaceSubclassCode_t interfacesubclass(ACInterfaceDescriptorSubtype_t) {
+	return AudioInterfaceSubclassCode_t::AUDIOCONTROL;
+}
+constexpr ClassCode_t interfaceclass(ASInterfaceDescriptorSubtype_t) { return ClassCode_t::Audio; }
+constexpr AudioInterfaceSubclassCode_t interfacesubclass(ASInterfaceDescriptorSubtype_t) {
+	return AudioInterfaceSubclassCode_t::AUDIOSTREAMING;
+}
+
 /* Table A-8: Audio Class-Specific Endpoint Descriptor Subtypes			 */
 enum class ACEndpointDescriptorSubtype_t : uint8_t {
 	DESCRIPTOR_UNDEFINED		= 0x00,
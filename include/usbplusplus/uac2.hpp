@@ -140,6 +140,12 @@ enum class ACInterfaceDescriptorSubtype_t : uint8_t {
 	SAMPLE_RATE_CONVERTER		= 0x0D
 };
 
+/* Interface class and subclass, class-specific descriptors of a subtype belong to */
+constexpr ClassCode_t interfaceclass(ACInterfaceDescriptorSubtype_t) { return ClassCode_t::Audio; }
+constexpr AudioInterfaceSubclassCode_t interfacesubclass(ACInterfaceDescriptorSubtype_t) {
+	return AudioInterfaceSubclassCode_t::AUDIOCONTROL;
+}
+
 /* Table A-10: Audio Class-Specific AS Interface Descriptor Subtypes		 */
 using uac1::ASInterfaceDescriptorSubtype_t;
 
@@ -904,4 +910,213 @@ AS_Isochronous_Audio_Data_Endpoint {
 	Number<2>					wLockDelay;
 };
 
-}}
+} // namespace uac2
+
+#if __cplusplus >= 201703L
+/*****************************************************************************/
+/*  Isochronous packet sizes 												 */
+/*****************************************************************************/
+
+namespace detail {
+/** Standard endpoint descriptor of an endpoint or of an AS Isochronous
+ *  Audio Data Endpoint														 */
+template<typename Endpoint>
+constexpr const usb2::Endpoint& standard_endpoint(const Endpoint& endpoint) {
+	if constexpr( std::is_same_v<Endpoint, uac2::AS_Isochronous_Audio_Data_Endpoint> )
+		return endpoint.endpoint;
+	else
+		return endpoint;
+}
+
+constexpr uint32_t gcd(uint32_t a, uint32_t b) {
+	return b == 0 ? a : gcd(b, a % b);
+}
+}
+
+namespace uac2 {
+
+/**
+ * Number of audio frames in each isochronous packet at SampleRate,
+ * computed at compile time from bSubslotSize of the format, the channel
+ * count and bInterval of the endpoint. Packets of min_frames and
+ * max_frames alternate, so that after period packets exactly
+ * SampleRate * period / (packets per second) frames are sent.
+ * The largest packet must fit wMaxPacketSize, including additional
+ * transactions per microframe at high speed.
+ * Usage:
+ *   using MySchedule = PacketSchedule<myFormat, myEndpoint, 2, 44100, BusSpeed_t::Full>;
+ *   MySchedule schedule {};
+ *   unsigned bytes = schedule.next() * MySchedule::frame_size; // in the ISR
+ */
+template<const auto& Format, const auto& Endpoint, unsigned Channels, uint32_t SampleRate, BusSpeed_t Speed>
+class PacketSchedule {
+	static constexpr const usb2::Endpoint& endpoint = detail::standard_endpoint(Endpoint);
+	static constexpr unsigned binterval = endpoint.bInterval.get();
+	static_assert(binterval >= 1 && binterval <= 16, "Isochronous bInterval must be 1 to 16");
+	/* samples per packet = SampleRate * 2^(bInterval-1) / (1000 or 8000)	 */
+	/* 64 bits, a 32 bit SampleRate shifted by up to 15 does not overflow	 */
+	static constexpr uint64_t numerator = uint64_t(SampleRate) << (binterval - 1);
+	static constexpr uint32_t denominator = Speed == BusSpeed_t::Full ? 1000 : 8000;
+	static_assert(numerator / denominator <= UINT16_MAX, "Too many frames per packet");
+	static constexpr uint32_t common = detail::gcd(static_cast<uint32_t>(numerator % denominator), denominator);
+	static constexpr uint32_t quotient = static_cast<uint32_t>(numerator / denominator);
+	static constexpr uint32_t remainder = static_cast<uint32_t>(numerator % denominator / common);
+public:
+	/** Bytes of one audio frame, a subslot per channel					 */
+	static constexpr unsigned frame_size = Channels * Format.bSubslotSize.get();
+	/** (Micro)frames per service interval									 */
+	static constexpr unsigned interval = 1u << (binterval - 1);
+	/** Microseconds between packets										 */
+	static constexpr unsigned interval_us = interval * (Speed == BusSpeed_t::Full ? 1000 : 125);
+	/** Packets, after which the sequence of sizes repeats					 */
+	static constexpr unsigned period = denominator / common;
+	static constexpr unsigned min_frames = quotient;
+	static constexpr unsigned max_frames = quotient + (remainder != 0);
+	static constexpr unsigned max_bytes = max_frames * frame_size;
+	static_assert(frame_size != 0, "Subslot size and channels must not be zero");
+	static_assert(max_bytes <= endpoint.wMaxPacketSize.bytes(),
+		"The largest packet does not fit wMaxPacketSize");
+
+	/** Frames in packet n of the period, for tables and tests				 */
+	static constexpr unsigned frames(unsigned n) {
+		n %= period;
+		return quotient + (n + 1) * remainder / period - n * remainder / period;
+	}
+	/** Frames in the next packet, one addition and one comparison			 */
+	constexpr unsigned next() {
+		accumulator += remainder;
+		if( accumulator < period ) return quotient;
+		accumulator -= period;
+		return quotient + 1;
+	}
+	/** Bytes in the next packet											 */
+	constexpr unsigned next_bytes() { return next() * frame_size; }
+	/** Restarts the sequence at packet zero								 */
+	constexpr void reset() { accumulator = 0; }
+private:
+	uint32_t accumulator = 0;
+};
+
+/*****************************************************************************/
+/*  5.2.3 Control Request Parameter Block Layout							 */
+/*****************************************************************************/
+
+/** MIN, MAX and RES of a subrange, bMIN, wMIN or dMIN by Size				 */
+template<unsigned Size, typename Signed = unsigned>
+struct __attribute__((__packed__))
+SubRange {
+	detail::field<Size, Signed>	MIN = 0;
+	detail::field<Size, Signed>	MAX = 0;
+	detail::field<Size, Signed>	RES = 0;
+};
+
+/** Parameter block of a CUR request, bCUR, wCUR or dCUR by Size			 */
+template<unsigned Size, typename Signed = unsigned>
+struct __attribute__((__packed__))
+CUR_Parameter_Block {
+	detail::field<Size, Signed>	CUR = 0;
+
+	/** Bytes of the block, up to wLength of the request					 */
+	DescriptorSpan span(uint16_t wLength = UINT16_MAX) const {
+		return { reinterpret_cast<const uint8_t*>(this), sizeof(*this) < wLength ? uint16_t(sizeof(*this)) : wLength };
+	}
+};
+
+/** Parameter block of a RANGE request, ascending non-overlapping subranges */
+template<unsigned Size, std::size_t NumSubRanges, typename Signed = unsigned>
+struct __attribute__((__packed__))
+RANGE_Parameter_Block {
+	static_assert(NumSubRanges > 0 && NumSubRanges <= UINT16_MAX, "Invalid number of subranges");
+	detail::field<2>			wNumSubRanges = static_cast<uint16_t>(NumSubRanges);
+	SubRange<Size, Signed>		subranges[NumSubRanges] = {};
+
+	/** Bytes of the block, up to wLength of the request. The host may ask
+	 *  for wNumSubRanges alone first, with wLength 2						 */
+	DescriptorSpan span(uint16_t wLength = UINT16_MAX) const {
+		return { reinterpret_cast<const uint8_t*>(this), sizeof(*this) < wLength ? uint16_t(sizeof(*this)) : wLength };
+	}
+};
+
+/* 5.2.3.1 Layout 1 Parameter Block											 */
+template<typename Signed = unsigned>
+using Layout_1_CUR = CUR_Parameter_Block<1, Signed>;
+template<std::size_t NumSubRanges, typename Signed = unsigned>
+using Layout_1_RANGE = RANGE_Parameter_Block<1, NumSubRanges, Signed>;
+/* 5.2.3.2 Layout 2 Parameter Block											 */
+template<typename Signed = unsigned>
+using Layout_2_CUR = CUR_Parameter_Block<2, Signed>;
+template<std::size_t NumSubRanges, typename Signed = unsigned>
+using Layout_2_RANGE = RANGE_Parameter_Block<2, NumSubRanges, Signed>;
+/* 5.2.3.3 Layout 3 Parameter Block											 */
+template<typename Signed = unsigned>
+using Layout_3_CUR = CUR_Parameter_Block<4, Signed>;
+template<std::size_t NumSubRanges, typename Signed = unsigned>
+using Layout_3_RANGE = RANGE_Parameter_Block<4, NumSubRanges, Signed>;
+} // namespace uac2
+
+namespace detail {
+/** Whether subranges of a RANGE parameter block ascend without overlapping */
+template<unsigned Size, std::size_t NumSubRanges, typename Signed>
+constexpr bool ascending(const uac2::RANGE_Parameter_Block<Size, NumSubRanges, Signed>& block) {
+	for(std::size_t i = 0; i < NumSubRanges; ++i) {
+		if( block.subranges[i].MIN.get() > block.subranges[i].MAX.get() ) return false;
+		if( i != 0 && block.subranges[i - 1].MAX.get() >= block.subranges[i].MIN.get() ) return false;
+	}
+	return true;
+}
+
+/** A subrange per frequency of a discrete sampling frequency table		 */
+template<std::size_t N>
+constexpr uac2::Layout_3_RANGE<N> frequency_range(const uac1::Type_I_DiscreteSampleFrequency<N>& table) {
+	uac2::Layout_3_RANGE<N> result {};
+	for(std::size_t i = 0; i < N; ++i)
+		result.subranges[i] = { table.tSamFreq[i].get(), table.tSamFreq[i].get(), 0 };
+	return result;
+}
+
+/** One subrange of a continuous sampling frequency range, with 1 Hz steps	 */
+constexpr uac2::Layout_3_RANGE<1> frequency_range(const uac1::Type_I_ContinuousSampleFrequency& range) {
+	return { 1, { { range.tLowerSamFreq.get(), range.tUpperSamFreq.get(), 1 } } };
+}
+}
+
+namespace uac2 {
+/**
+ * RANGE of the sampling frequency control of a clock source, Layout 3,
+ * a subrange per rate, built at compile time and placed in ROM.
+ * Usage:
+ *   static constexpr auto rates = sampling_frequency_range<44100, 48000, 96000>();
+ *   return rates.span(request.wLength); // GET RANGE CS_SAM_FREQ_CONTROL
+ */
+template<uint32_t ... Rates>
+constexpr Layout_3_RANGE<sizeof...(Rates)> sampling_frequency_range() {
+	constexpr Layout_3_RANGE<sizeof...(Rates)> result { sizeof...(Rates), { { Rates, Rates, 0 } ... } };
+	static_assert(detail::ascending(result), "Rates must ascend");
+	return result;
+}
+
+/**
+ * RANGE of the sampling frequency control, Layout 3, with the rates
+ * declared in a UAC1 Type I Format Type descriptor, discrete or continuous
+ */
+template<const auto& Format>
+constexpr auto sampling_frequency_range_of() {
+	constexpr auto result = detail::frequency_range(Format.samfreq);
+	static_assert(detail::ascending(result), "Sampling frequencies must ascend");
+	return result;
+}
+
+/**
+ * RANGE of a volume control, Layout 2, in 1/256 dB steps.
+ * Usage:
+ *   static constexpr auto volume = volume_range<-100 * 256, 0, 256>();
+ */
+template<int16_t Min, int16_t Max, int16_t Res>
+constexpr Layout_2_RANGE<1, signed> volume_range() {
+	static_assert(Min <= Max && Res > 0, "Invalid volume range");
+	return { 1, { { Min, Max, Res } } };
+}
+} // namespace uac2
+#endif
+
+}
@@ -65,6 +65,7 @@
  */
 
 #include <cstdint>
+#include <type_traits>
 #include "usblangids.hpp"
 #include "byteorder.hpp"
 #include "ustring.hpp"
@@ -180,7 +181,9 @@ enum class DescriptorType_t : uint8_t {
 	BOS 			 = 15,
 	DEVICE_CAPABILITY= 16,
 	WIRELESS_ENDPOINT_COMPANION = 17,
-
+	/* USB 3.2, Table 9-6. Descriptor Types									*/
+	SUPERSPEED_USB_ENDPOINT_COMPANION = 48,
+	SUPERSPEEDPLUS_ISOCHRONOUS_ENDPOINT_COMPANION = 49,
 };
 
 /* Table 9-6. Standard Feature Selectors									*/
@@ -238,6 +241,12 @@ enum class TransferType_t : uint8_t {
 template<> inline constexpr bool enable_or<TransferType_t> = true;
 template<> inline constexpr bool enable_and<TransferType_t> = true;
 
+/** Bus speed, a configuration or an endpoint is meant for					 */
+enum class BusSpeed_t : uint8_t {
+	Full,
+	High
+};
+
 namespace detail {
 
 template<unsigned Size, typename Signed = unsigned>
@@ -288,6 +297,15 @@ struct first<First, List...> {
 	using type = First;
 };
 
+/** true if every of the values is true									 */
+template<typename ... Bool>
+constexpr bool all_of(Bool ... values) {
+	const bool items[] = { true, values ... };
+	for(bool item : items)
+		if( ! item ) return false;
+	return true;
+}
+
 /** one-based list indexer  												*/
 template<typename T, T ... List>
 struct index;
@@ -486,13 +504,51 @@ EndpointAddress : detail::field<1> {
 		field<1>(static_cast<type>((number & 0x7F) | (static_cast<type>(dir) << 7))) {}
 };
 
+/** Table 9-13. wMaxPacketSize, bits 10..0 - maximum packet size,
+ *  bits 12..11 - number of additional transactions per microframe		 */
 struct __attribute__((__packed__))
 MaxPacketSize : detail::field<2> {
 	using typename detail::field<2>::type;
 	constexpr MaxPacketSize(type size) :
 		field<2>(size) {}
+	/** Maximum packet size in bytes										 */
+	constexpr unsigned size() const { return get() & 0x7FFu; }
+	/** Transactions per microframe, 1 to 3								 */
+	constexpr unsigned transactions() const { return 1 + ((get() >> 11) & 0b11u); }
+	/** Payload bytes per (micro)frame									 */
+	constexpr unsigned bytes() const { return size() * transactions(); }
 };
 
+/**
+ * wMaxPacketSize, validated for the transfer type and the bus speed at
+ * compile time, USB 2.0, 5.5.3, 5.6.3, 5.7.3, 5.8.3 and Table 9-14.
+ * Transactions above one are for high speed, high-bandwidth isochronous
+ * and interrupt endpoints only.
+ * Usage:
+ *   .wMaxPacketSize = maxpacketsize<TransferType_t::Isochronous, BusSpeed_t::High, 1024, 3>(),
+ */
+template<TransferType_t Type, BusSpeed_t Speed, unsigned Size, unsigned Transactions = 1>
+constexpr MaxPacketSize maxpacketsize() {
+	constexpr bool high = Speed == BusSpeed_t::High;
+	constexpr bool periodic = Type == TransferType_t::Isochronous || Type == TransferType_t::Interrupt;
+	static_assert(Transactions >= 1 && Transactions <= 3, "Transactions must be 1, 2 or 3");
+	static_assert(Transactions == 1 || (high && periodic),
+		"Additional transactions are for high speed isochronous and interrupt endpoints");
+	static_assert(Type != TransferType_t::Control || (high ? Size == 64 :
+		Size == 8 || Size == 16 || Size == 32 || Size == 64), "Invalid control endpoint packet size");
+	static_assert(Type != TransferType_t::Bulk || (high ? Size == 512 :
+		Size == 8 || Size == 16 || Size == 32 || Size == 64), "Invalid bulk endpoint packet size");
+	static_assert(Type != TransferType_t::Isochronous || Size <= (high ? 1024 : 1023),
+		"Isochronous endpoint packet size is too large");
+	static_assert(Type != TransferType_t::Interrupt || Size <= (high ? 1024 : 64),
+		"Interrupt endpoint packet size is too large");
+	static_assert(Transactions != 2 || (Size >= 513 && Size <= 1024),
+		"Two transactions require packet size of 513 to 1024 bytes");
+	static_assert(Transactions != 3 || (Size >= 683 && Size <= 1024),
+		"Three transactions require packet size of 683 to 1024 bytes");
+	return MaxPacketSize(static_cast<MaxPacketSize::type>(Size | (Transactions - 1) << 11));
+}
+
 /*****************************************************************************/
 /*  Collections																 */
 /*****************************************************************************/
@@ -510,8 +566,49 @@ Array {
 	static constexpr unsigned count = Count;
 };
 
+#if __cplusplus >= 201703L
+namespace detail {
+/** Storage of one List item, indexed to keep repeated item types distinct */
+template<std::size_t Index, class Item>
+struct __attribute__((__packed__))
+list_item {
+	Item item;
+};
+
+template<typename Sequence, class ... Item>
+struct list_items;
+
+/** Items, laid out back to back as bases, one initializer per item		 */
+template<std::size_t ... Index, class ... Item>
+struct __attribute__((__packed__))
+list_items<std::index_sequence<Index...>, Item...> : list_item<Index, Item> ... {
+	/** Calls f for each item in the declared order				 */
+	template<typename F>
+	constexpr void each(F&& f) const { (f(list_item<Index, Item>::item), ...); }
+	template<typename F>
+	constexpr void each(F&& f) { (f(list_item<Index, Item>::item), ...); }
+};
+}
+
+/**
+ * List of more than 11 items. Each item is initialized from one initializer,
+ * which must be either an expression of the item type, e.g. Endpoint{...},
+ * or a braced list, not starting with a braced list
+ */
+template<class ... Item>
+struct __attribute__((__packed__))
+List {
+	static_assert(sizeof...(Item) > 0, "Use Empty for a list of no items");
+	static constexpr unsigned count = sizeof...(Item);
+	using type = detail::list_items<std::index_sequence_for<Item...>, Item...>;
+};
+#else
 template<class ... Item>
-struct List;
+struct List {
+	static_assert(sizeof...(Item) > 0, "Use Empty for a list of no items");
+	static_assert(sizeof...(Item) <= 11, "Lists of more than 11 items require C++17");
+};
+#endif
 
 template<class Item0>
 struct __attribute__((__packed__))
@@ -519,6 +616,11 @@ List<Item0> {
 	static constexpr unsigned count = 1;
 	struct __attribute__((__packed__)) type {
 		Item0 item0;
+		/** Calls f for each item in the declared order				 */
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); }
 	};
 };
 template<class Item0, class Item1>
@@ -529,6 +631,10 @@ List<
 	struct __attribute__((__packed__)) type {
 		Item0 item0;
 		Item1 item1;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); }
 	};
 };
 template<class Item0, class Item1, class Item2>
@@ -540,6 +646,10 @@ List<
 		Item0 item0;
 		Item1 item1;
 		Item2 item2;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); }
 	};
 };
 template<class Item0, class Item1, class Item2, class Item3>
@@ -552,6 +662,10 @@ List<
 		Item1 item1;
 		Item2 item2;
 		Item3 item3;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); f(item3); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); f(item3); }
 	};
 };
 template<class Item0, class Item1, class Item2, class Item3, class Item4>
@@ -565,6 +679,10 @@ List<
 		Item2 item2;
 		Item3 item3;
 		Item4 item4;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); f(item3); f(item4); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); f(item3); f(item4); }
 	};
 };
 template<class Item0, class Item1, class Item2, class Item3, class Item4,
@@ -580,6 +698,10 @@ List<Item0, Item1,
 		Item3 item3;
 		Item4 item4;
 		Item5 item5;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); }
 	};
 };
 template<class Item0, class Item1, class Item2, class Item3, class Item4,
@@ -596,6 +718,10 @@ List<Item0,
 		Item4 item4;
 		Item5 item5;
 		Item6 item6;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); }
 	};
 };
 template<class Item0, class Item1, class Item2, class Item3, class Item4,
@@ -613,6 +739,10 @@ List<
 		Item5 item5;
 		Item6 item6;
 		Item7 item7;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); f(item7); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); f(item7); }
 	};
 };
 
@@ -620,7 +750,7 @@ template<class Item0, class Item1, class Item2, class Item3, class Item4,
 		class Item5, class Item6, class Item7, class Item8>
 struct __attribute__((__packed__))
 List<Item0, Item1, Item2, Item3, Item4, Item5, Item6, Item7, Item8> {
-	static constexpr unsigned count = 8;
+	static constexpr unsigned count = 9;
 	struct __attribute__((__packed__)) type {
 		Item0 item0;
 		Item1 item1;
@@ -631,6 +761,10 @@ List<Item0, Item1, Item2, Item3, Item4, Item5, Item6, Item7, Item8> {
 		Item6 item6;
 		Item7 item7;
 		Item8 item8;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); f(item7); f(item8); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); f(item7); f(item8); }
 	};
 };
 
@@ -638,7 +772,7 @@ template<class Item0, class Item1, class Item2, class Item3, class Item4,
 		class Item5, class Item6, class Item7, class Item8, class Item9>
 struct __attribute__((__packed__))
 List<Item0, Item1, Item2, Item3, Item4, Item5, Item6, Item7, Item8, Item9> {
-	static constexpr unsigned count = 8;
+	static constexpr unsigned count = 10;
 	struct __attribute__((__packed__)) type {
 		Item0 item0;
 		Item1 item1;
@@ -650,6 +784,10 @@ List<Item0, Item1, Item2, Item3, Item4, Item5, Item6, Item7, Item8, Item9> {
 		Item7 item7;
 		Item8 item8;
 		Item9 item9;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); f(item7); f(item8); f(item9); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); f(item7); f(item8); f(item9); }
 	};
 };
 
@@ -659,7 +797,7 @@ template<class Item0, class Item1, class Item2, class Item3, class Item4,
 struct __attribute__((__packed__))
 List<Item0, Item1, Item2, Item3, Item4, Item5, Item6, Item7, Item8, Item9,
 	Item10> {
-	static constexpr unsigned count = 8;
+	static constexpr unsigned count = 11;
 	struct __attribute__((__packed__)) type {
 		Item0 item0;
 		Item1 item1;
@@ -672,9 +810,18 @@ List<Item0, Item1, Item2, Item3, Item4, Item5, Item6, Item7, Item8, Item9,
 		Item8 item8;
 		Item9 item9;
 		Item10 item10;
+		template<typename F>
+		constexpr void each(F&& f) const { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); f(item7); f(item8); f(item9); f(item10); }
+		template<typename F>
+		constexpr void each(F&& f) { f(item0); f(item1); f(item2); f(item3); f(item4); f(item5); f(item6); f(item7); f(item8); f(item9); f(item10); }
 	};
 };
 
+#if __cplusplus >= 201703L
+template<typename Configuration>
+constexpr uint8_t numinterfaces_of(const Configuration& configuration);
+#endif
+
 /*****************************************************************************/
 /*  USB1 entities 							 								 */
 /*****************************************************************************/
@@ -758,6 +905,10 @@ Configuration {
 	}
 	static constexpr uint16_t totallength() { return sizeof(self); }
 	static constexpr uint8_t length() {	return sizeof(Configuration<Empty>); }
+#if __cplusplus >= 201703L
+	/** Number of unique interface numbers, bNumInterfaces must match it	 */
+	constexpr uint8_t numinterfaces() const { return numinterfaces_of(*this); }
+#endif
 	const uint8_t* ptr() const { return bLength.ptr(); }
 
 	/* ------------------------------------------------*/
@@ -818,6 +969,7 @@ Endpoint {
 	Attributes : private detail::field<1> {
 		constexpr Attributes(TransferType_t transferType)
 		  : detail::field<1>(static_cast<type>(transferType & TransferType_t::__mask)) {}
+		using detail::field<1>::get;
 	};
 	static constexpr DescriptorType_t descriptortype() {
 		return DescriptorType_t::ENDPOINT;
@@ -857,10 +1009,10 @@ Languages {
 /*****************************************************************************/
 /*  Table 9-16. UNICODE String Descriptor									 */
 /** String Descriptor												 		 */
-template<ustring string>
+template<USBPLUSPLUS_STRING string>
 struct String {
 	using self = String<string>;
-	static constexpr unsigned len = usbplusplus::length(string);
+	static constexpr unsigned len = ustring_view(string).size;
 	static constexpr DescriptorType_t descriptortype() {
 		return DescriptorType_t::STRING;
 	}
@@ -870,7 +1022,7 @@ struct String {
 	/* ------------------------------------------------*/
 	Length<self>				bLength {};
 	DescriptorType<self>		bDescriptorType {};
-	utf16le<len> 				bString {string};
+	utf16le<len> 				bString {ustring_view(string)};
 };
 
 }
@@ -969,9 +1121,10 @@ Other_Speed_Configuration {
 		return DescriptorType_t::OTHER_SPEED;
 	}
 	static constexpr uint16_t totallength() { return sizeof(self); }
-	static constexpr uint8_t numinterfaces() {
-		return InterfaceCollection::count;
-	}
+#if __cplusplus >= 201703L
+	/** Number of unique interface numbers, bNumInterfaces must match it	 */
+	constexpr uint8_t numinterfaces() const { return numinterfaces_of(*this); }
+#endif
 	static constexpr uint8_t length() {
 		return sizeof(Other_Speed_Configuration<Empty>);
 	}
@@ -981,7 +1134,10 @@ Other_Speed_Configuration {
 	Length<self> 				bLength;
 	DescriptorType<self> 		bDescriptorType;
 	TotalLength<self>			wTotalLength;
-	FixedNumber<self>			bNumInterfaces { numinterfaces() };
+	/* Items in the collection, if omitted, an interface with alternate
+	 * settings is counted more than once, use count_interfaces to fix		 */
+	NumInterfaces				bNumInterfaces {
+		static_cast<NumInterfaces::type>(InterfaceCollection::count) };
 	ConfigurationValue			bConfigurationValue;
 	Index						iConfiguration;
 	Attributes					bmAttributes;
@@ -1002,6 +1158,7 @@ Endpoint {
 		  : detail::field<1>(static_cast<type>(transfer |sync | usage)) {}
 		constexpr Attributes(TransferType_t transferType)
 		  : detail::field<1>(static_cast<type>(transferType) & 0b11) {}
+		using detail::field<1>::get;
 	};
 	static constexpr DescriptorType_t descriptortype() {
 		return DescriptorType_t::ENDPOINT;
@@ -1043,15 +1200,1008 @@ InterfaceAssociation {
 };
 }
 
+/*****************************************************************************/
+/*  USB3 entities 							 								 */
+/*  Based on USB 3.2 specification, Revision 1.1							 */
+/*****************************************************************************/
+namespace usb3 {
+/** USB 3.2, Table 9-14. Device Capability Type Codes						 */
+enum class DevCapabilityType_t : uint8_t {
+	Wireless_USB		= 0x01,
+	USB_2_0_Extension	= 0x02,
+	SuperSpeed_USB		= 0x03,
+	Container_ID		= 0x04,
+	Platform			= 0x05,
+	Power_Delivery_Capability = 0x06,
+	Battery_Info_Capability = 0x07,
+	PD_Consumer_Port_Capability = 0x08,
+	PD_Provider_Port_Capability = 0x09,
+	SuperSpeed_Plus		= 0x0A,
+	Precision_Time_Measurement = 0x0B,
+	Wireless_USB_Ext	= 0x0C,
+	Billboard			= 0x0D,
+	Authentication		= 0x0E,
+	Billboard_Ex		= 0x0F,
+	Configuration_Summary = 0x10
+};
+
+/** USB 3.2, Table 9-15. USB 2.0 Extension Descriptor, bmAttributes		 */
+enum class Usb2ExtensionAttributes_t : uint32_t {
+	None				= 0,
+	LPM					= D(1),
+	BESL				= D(2),
+	Baseline_BESL_valid	= D(3),
+	Deep_BESL_valid		= D(4)
+};
+
+/** USB 3.2, Table 9-16. SuperSpeed USB Device Capability, bmAttributes	 */
+enum class SuperSpeedAttributes_t : uint8_t {
+	None				= 0,
+	LTM_capable			= D(1)
+};
+
+/** USB 3.2, Table 9-16. SuperSpeed USB Device Capability, wSpeedsSupported */
+enum class SpeedsSupported_t : uint16_t {
+	Low_Speed			= D(0),
+	Full_Speed			= D(1),
+	High_Speed			= D(2),
+	Gen1_Speed			= D(3)
+};
+
+/** USB 3.2, Table 9-16. bFunctionalitySupport, the lowest speed at which
+ *  all the functionality of the device is available						 */
+enum class FunctionalitySupport_t : uint8_t {
+	Low_Speed, Full_Speed, High_Speed, Gen1_Speed
+};
+}
+template<> inline constexpr bool enable_or<usb3::Usb2ExtensionAttributes_t> = true;
+template<> inline constexpr bool enable_or<usb3::SpeedsSupported_t> = true;
+
+namespace usb3 {
+using usb2::DeviceClass;
+using usb2::DeviceSubClass;
+using usb2::DeviceProtocol;
+using usb2::InterfaceClass;
+using usb2::InterfaceSubClass;
+using usb2::InterfaceProtocol;
+using usb2::IDVendor;
+using usb2::IDProduct;
+using usb2::Manufacturer;
+using usb2::Product;
+using usb2::SerialNumber;
+using usb2::Device;
+using usb2::Interface;
+using usb2::AlternateSettings;
+using usb2::Configuration;
+using usb2::Languages;
+using usb2::String;
+using usb2::InterfaceAssociation;
+using usb2::SynchronizationType_t;
+using usb2::UsageType_t;
+
+template<typename T>
+struct __attribute__((__packed__))
+DevCapabilityType : detail::typed<DevCapabilityType_t> {
+	constexpr DevCapabilityType() :
+		detail::typed<DevCapabilityType_t>(T::devcapabilitytype()) {}
+};
+
+template<typename T>
+struct __attribute__((__packed__))
+NumDeviceCaps : protected FixedNumber<T> {
+	using typename FixedNumber<T>::type;
+	using FixedNumber<T>::get;
+	constexpr NumDeviceCaps() : FixedNumber<T>(T::numdevicecaps()) {}
+};
+
+/*****************************************************************************/
+/*  USB 3.2, Table 9-12. BOS Descriptor									 */
+/** Binary device Object Store, followed by device capability descriptors	 */
+template<class CapabilityCollection>
+struct __attribute__((__packed__))
+BOS {
+	using self = BOS<CapabilityCollection>;
+	using Capabilities = typename CapabilityCollection::type;
+	static constexpr DescriptorType_t descriptortype() {
+		return DescriptorType_t::BOS;
+	}
+	static constexpr FixedNumber<self> numdevicecaps() {
+		return FixedNumber<self>(CapabilityCollection::count);
+	}
+	static constexpr uint16_t totallength() { return sizeof(self); }
+	static constexpr uint8_t length() { return sizeof(BOS<Empty>); }
+	const uint8_t* ptr() const { return bLength.ptr(); }
+
+	/* ------------------------------------------------*/
+	Length<self>				bLength;
+	DescriptorType<self>		bDescriptorType;
+	TotalLength<self>			wTotalLength;
+	NumDeviceCaps<self>			bNumDeviceCaps;
+	Capabilities				capabilities;
+};
+
+/*****************************************************************************/
+/*  USB 3.2, Table 9-15. USB 2.0 Extension Descriptor						 */
+/** USB 2.0 Extension, required of a SuperSpeed device, operating at
+ *  high speed																 */
+struct __attribute__((__packed__))
+USB_2_0_Extension {
+	using self = USB_2_0_Extension;
+	struct __attribute__((__packed__))
+	Attributes : private detail::field<4> {
+		/** BESL values are in bits 11..8 and 15..12						 */
+		constexpr Attributes(Usb2ExtensionAttributes_t attributes = Usb2ExtensionAttributes_t::None,
+				uint8_t baselineBESL = 0, uint8_t deepBESL = 0)
+		  : detail::field<4>(static_cast<type>(attributes) |
+				static_cast<type>(baselineBESL & 0xF) << 8 | static_cast<type>(deepBESL & 0xF) << 12) {}
+		using detail::field<4>::get;
+	};
+	static constexpr DescriptorType_t descriptortype() {
+		return DescriptorType_t::DEVICE_CAPABILITY;
+	}
+	static constexpr DevCapabilityType_t devcapabilitytype() {
+		return DevCapabilityType_t::USB_2_0_Extension;
+	}
+	static constexpr uint8_t length() { return sizeof(self); }
+	const uint8_t* ptr() const { return bLength.ptr(); }
+
+	/* ------------------------------------------------*/
+	Length<self>				bLength;
+	DescriptorType<self>		bDescriptorType;
+	DevCapabilityType<self>		bDevCapabilityType;
+	Attributes					bmAttributes;
+};
+
+/*****************************************************************************/
+/*  USB 3.2, Table 9-16. SuperSpeed USB Device Capability Descriptor		 */
+/** SuperSpeed USB Device Capability										 */
+struct __attribute__((__packed__))
+SuperSpeed_USB {
+	using self = SuperSpeed_USB;
+	using Attributes = detail::typed<SuperSpeedAttributes_t>;
+	using SpeedsSupported = detail::typed<SpeedsSupported_t>;
+	using FunctionalitySupport = detail::typed<FunctionalitySupport_t>;
+	/** U1 Device Exit Latency, 0 to 10 microseconds						 */
+	struct __attribute__((__packed__))
+	U1DevExitLat : detail::field<1> {
+		constexpr U1DevExitLat(type us) : detail::field<1>(us) {}
+	};
+	/** U2 Device Exit Latency, 0 to 2047 microseconds					 */
+	struct __attribute__((__packed__))
+	U2DevExitLat : detail::field<2> {
+		constexpr U2DevExitLat(type us) : detail::field<2>(us) {}
+	};
+	static constexpr DescriptorType_t descriptortype() {
+		return DescriptorType_t::DEVICE_CAPABILITY;
+	}
+	static constexpr DevCapabilityType_t devcapabilitytype() {
+		return DevCapabilityType_t::SuperSpeed_USB;
+	}
+	static constexpr uint8_t length() { return sizeof(self); }
+	const uint8_t* ptr() const { return bLength.ptr(); }
+
+	/* ------------------------------------------------*/
+	Length<self>				bLength;
+	DescriptorType<self>		bDescriptorType;
+	DevCapabilityType<self>		bDevCapabilityType;
+	Attributes					bmAttributes;
+	SpeedsSupported				wSpeedsSupported;
+	FunctionalitySupport		bFunctionalitySupport;
+	U1DevExitLat				bU1DevExitLat;
+	U2DevExitLat				wU2DevExitLat;
+};
+
+/*****************************************************************************/
+/*  USB 3.2, Table 9-27. SuperSpeed Endpoint Companion Descriptor			 */
+/** SuperSpeed Endpoint Companion, see also bulk_companion and
+ *  periodic_companion														 */
+struct __attribute__((__packed__))
+Endpoint_Companion {
+	using self = Endpoint_Companion;
+	/** Packets in a burst less one, 0 to 15								 */
+	struct __attribute__((__packed__))
+	MaxBurst : detail::field<1> {
+		constexpr MaxBurst(type v) : detail::field<1>(v) {}
+	};
+	/** Bulk: bits 4..0 MaxStreams, log2 of the number of streams.
+	 *  Isochronous: bits 1..0 Mult, maximum packets in a service interval
+	 *  are (bMaxBurst + 1) * (Mult + 1)										 */
+	struct __attribute__((__packed__))
+	Attributes : detail::field<1> {
+		constexpr Attributes(type v = 0) : detail::field<1>(v) {}
+	};
+	struct __attribute__((__packed__))
+	BytesPerInterval : detail::field<2> {
+		constexpr BytesPerInterval(type v = 0) : detail::field<2>(v) {}
+	};
+	static constexpr DescriptorType_t descriptortype() {
+		return DescriptorType_t::SUPERSPEED_USB_ENDPOINT_COMPANION;
+	}
+	static constexpr uint8_t length() { return sizeof(self); }
+	const uint8_t* ptr() const { return bLength.ptr(); }
+
+	/* ------------------------------------------------*/
+	Length<self>				bLength;
+	DescriptorType<self>		bDescriptorType;
+	MaxBurst					bMaxBurst;
+	Attributes					bmAttributes;
+	BytesPerInterval			wBytesPerInterval;
+};
+
+/**
+ * Companion of a bulk endpoint, validated at compile time.
+ * MaxStreams is log2 of the number of streams, 0 to 16.
+ * Usage:
+ *   .companion = bulk_companion<15, 4>(),
+ */
+template<unsigned MaxBurst, unsigned MaxStreams = 0>
+constexpr Endpoint_Companion bulk_companion() {
+	static_assert(MaxBurst <= 15, "bMaxBurst must be 0 to 15");
+	static_assert(MaxStreams <= 16, "MaxStreams must be 0 to 16");
+	return { {}, {}, MaxBurst, MaxStreams, 0 };
+}
+
+/**
+ * Companion of an isochronous or interrupt endpoint, validated at compile
+ * time. BytesPerInterval defaults to the most the endpoint may transfer in
+ * a service interval, (MaxBurst + 1) * (Mult + 1) * MaxPacketSize.
+ * Mult is for isochronous endpoints only.
+ * Usage:
+ *   .companion = periodic_companion<TransferType_t::Isochronous, 1024, 15, 2>(),
+ */
+template<TransferType_t Type, unsigned MaxPacketSize, unsigned MaxBurst = 0, unsigned Mult = 0,
+	unsigned BytesPerInterval = (MaxBurst + 1) * (Mult + 1) * MaxPacketSize>
+constexpr Endpoint_Companion periodic_companion() {
+	static_assert(Type == TransferType_t::Isochronous || Type == TransferType_t::Interrupt,
+		"Periodic companion is for isochronous and interrupt endpoints");
+	static_assert(MaxPacketSize <= 1024, "wMaxPacketSize must not exceed 1024");
+	static_assert(MaxBurst <= 15, "bMaxBurst must be 0 to 15");
+	static_assert(MaxBurst == 0 || MaxPacketSize == 1024, "Bursts require wMaxPacketSize of 1024");
+	static_assert(Mult <= 2, "Mult must be 0 to 2");
+	static_assert(Mult == 0 || Type == TransferType_t::Isochronous, "Mult is for isochronous endpoints");
+	static_assert(BytesPerInterval <= (MaxBurst + 1) * (Mult + 1) * MaxPacketSize,
+		"wBytesPerInterval exceeds the packets of the service interval");
+	return { {}, {}, MaxBurst, Mult, BytesPerInterval };
+}
+
+/*****************************************************************************/
+/*  USB 3.2, Table 9-26. Standard Endpoint Descriptor						 */
+/** Standard Endpoint Descriptor, followed by its SuperSpeed Endpoint
+ *  Companion																 */
+struct __attribute__((__packed__))
+Endpoint {
+	using self = Endpoint;
+	using Attributes = usb2::Endpoint::Attributes;
+	static constexpr DescriptorType_t descriptortype() {
+		return DescriptorType_t::ENDPOINT;
+	}
+	static constexpr uint8_t length() { return sizeof(usb2::Endpoint); }
+	const uint8_t* ptr() const { return bLength.ptr(); }
+
+	/* ------------------------------------------------*/
+	Length<self>				bLength;
+	DescriptorType<self>		bDescriptorType;
+	EndpointAddress				bEndpointAddress;
+	Attributes					bmAttributes;
+	MaxPacketSize				wMaxPacketSize;
+	Interval					bInterval;
+	/* the companion descriptor follows the endpoint descriptor				 */
+	Endpoint_Companion			companion;
+};
+}
+
+#if __cplusplus >= 201703L
+/*****************************************************************************/
+/*  Configuration index 						 							 */
+/*****************************************************************************/
+
+namespace detail {
+template<typename T, typename = void>
+struct has_each : std::false_type {};
+
+template<typename T>
+struct has_each<T, std::void_t<decltype(std::declval<const T&>().each(std::declval<void(*)(int)>()))>>
+  : std::true_type {};
+
+template<typename T, typename = void>
+struct has_interfaces : std::false_type {};
+
+template<typename T>
+struct has_interfaces<T, std::void_t<decltype(std::declval<const T&>().interfaces)>> : std::true_type {};
+
+template<typename T, typename = void>
+struct has_endpoints : std::false_type {};
+
+template<typename T>
+struct has_endpoints<T, std::void_t<decltype(std::declval<const T&>().endpoints)>> : std::true_type {};
+
+template<typename T, typename = void>
+struct has_interface_number : std::false_type {};
+
+template<typename T>
+struct has_interface_number<T, std::void_t<decltype(std::declval<const T&>().bInterfaceNumber.get())>>
+  : std::true_type {};
+
+template<typename T, typename = void>
+struct has_endpoint_address : std::false_type {};
+
+template<typename T>
+struct has_endpoint_address<T, std::void_t<decltype(std::declval<const T&>().bEndpointAddress.get())>>
+  : std::true_type {};
+
+template<typename T, typename = void>
+struct has_first_interface : std::false_type {};
+
+template<typename T>
+struct has_first_interface<T, std::void_t<decltype(std::declval<const T&>().bFirstInterface.get())>>
+  : std::true_type {};
+
+template<typename Visitor, typename T, typename = void>
+struct visits_associations : std::false_type {};
+
+template<typename Visitor, typename T>
+struct visits_associations<Visitor, T,
+	std::void_t<decltype(std::declval<Visitor&>().association(std::declval<T&>(), 0u))>>
+  : std::true_type {};
+
+/** Walks descriptor tree, reporting interface and endpoint descriptors with
+ *  their offsets to the visitor in the order they appear in the descriptor.
+ *  Interface association descriptors are reported to visitors that have
+ *  method association. Descriptors are passed as const if the tree is const.
+ *  Nested collections are the last members of their descriptors			 */
+template<typename Visitor, typename Descriptor>
+constexpr void walk(Visitor& visitor, Descriptor& descriptor, unsigned offset = 0) {
+	if constexpr( has_each<Descriptor>::value ) {
+		descriptor.each([&visitor, &offset](auto& item) {
+			walk(visitor, item, offset);
+			offset += sizeof(item);
+		});
+	} else if constexpr( std::is_array_v<Descriptor> ) {
+		for(auto& item : descriptor) {
+			walk(visitor, item, offset);
+			offset += sizeof(item);
+		}
+	} else {
+		if constexpr( has_first_interface<Descriptor>::value &&
+				visits_associations<Visitor, Descriptor>::value )
+			visitor.association(descriptor, offset);
+		if constexpr( has_interface_number<Descriptor>::value )
+			visitor.interface(descriptor, offset);
+		if constexpr( has_endpoint_address<Descriptor>::value )
+			visitor.endpoint(descriptor, offset);
+		if constexpr( has_interfaces<Descriptor>::value )
+			walk(visitor, descriptor.interfaces,
+				offset + sizeof(Descriptor) - sizeof(descriptor.interfaces));
+		if constexpr( has_endpoints<Descriptor>::value )
+			walk(visitor, descriptor.endpoints,
+				offset + sizeof(Descriptor) - sizeof(descriptor.endpoints));
+	}
+}
+
+/** Endpoint addresses compacted to number and direction, 0..31			 */
+inline constexpr unsigned endpoint_slot(unsigned address) {
+	return (address & 0x0F) | ((address & 0x80) >> 3);
+}
+constexpr unsigned endpoint_slots = 32;
+
+/** Number of interface descriptors and of interface numbers				 */
+struct interface_census {
+	template<typename Interface>
+	constexpr void interface(const Interface& descriptor, unsigned) {
+		const unsigned number = descriptor.bInterfaceNumber.get();
+		++count;
+		numbers = number < numbers ? numbers : number + 1;
+	}
+	template<typename Endpoint>
+	constexpr void endpoint(const Endpoint&, unsigned) {}
+	unsigned count;
+	unsigned numbers;
+};
+
+struct interface_entry {
+	uint8_t number;
+	uint8_t alternate;
+	uint16_t offset;
+};
+
+/** Offsets of interface descriptors, ordered by number and alternate
+ *  setting, and of endpoint descriptors, indexed by endpoint_slot		 */
+template<unsigned Count, unsigned Numbers>
+struct configuration_offsets {
+	template<typename Configuration>
+	constexpr configuration_offsets(const Configuration& configuration)
+	  : entries {}, first {}, endpoints {}, next {} {
+		walk(*this, configuration);
+		for(unsigned n = 1; n < next; ++n)
+			for(unsigned k = n; k > 0 && precedes(entries[k], entries[k - 1]); --k) {
+				const interface_entry entry = entries[k];
+				entries[k] = entries[k - 1];
+				entries[k - 1] = entry;
+			}
+		for(unsigned n = 0, pos = 0; n <= Numbers; ++n) {
+			while( pos < next && entries[pos].number < n ) ++pos;
+			first[n] = static_cast<uint8_t>(pos);
+		}
+	}
+	template<typename Interface>
+	constexpr void interface(const Interface& descriptor, unsigned offset) {
+		entries[next++] = {
+			descriptor.bInterfaceNumber.get(),
+			descriptor.bAlternateSetting.get(),
+			static_cast<uint16_t>(offset)
+		};
+	}
+	template<typename Endpoint>
+	constexpr void endpoint(const Endpoint& descriptor, unsigned offset) {
+		endpoints[endpoint_slot(descriptor.bEndpointAddress.get())] = static_cast<uint16_t>(offset);
+	}
+	/** Offset of the interface descriptor, or zero if there is none. Takes
+	 *  one step when alternate settings are numbered from zero without gaps */
+	constexpr unsigned find(unsigned number, unsigned alternate) const {
+		if( number >= Numbers ) return 0;
+		const unsigned pos = first[number] + alternate;
+		if( pos < first[number + 1] && entries[pos].alternate == alternate )
+			return entries[pos].offset;
+		for(unsigned n = first[number]; n < first[number + 1]; ++n)
+			if( entries[n].alternate == alternate ) return entries[n].offset;
+		return 0;
+	}
+	static constexpr bool precedes(interface_entry a, interface_entry b) {
+		return a.number < b.number || (a.number == b.number && a.alternate < b.alternate);
+	}
+	interface_entry entries[Count ? Count : 1];
+	/* entries of interface n are entries[first[n]] ... entries[first[n+1]-1] */
+	uint8_t first[Numbers + 1];
+	uint16_t endpoints[endpoint_slots];
+	unsigned next;
+};
+
+template<typename Configuration>
+constexpr interface_census census_of(const Configuration& configuration) {
+	interface_census census {};
+	walk(census, configuration);
+	return census;
+}
+
+/** Set of interface numbers in a configuration							 */
+struct interface_numbers {
+	template<typename Interface>
+	constexpr void interface(const Interface& descriptor, unsigned) {
+		const unsigned number = descriptor.bInterfaceNumber.get();
+		const uint32_t bit = 1u << (number % 32);
+		count += (bits[number / 32] & bit) == 0;
+		bits[number / 32] |= bit;
+	}
+	template<typename Endpoint>
+	constexpr void endpoint(const Endpoint&, unsigned) {}
+	uint32_t bits[8];
+	unsigned count;
+};
+
+template<typename T, typename = void>
+struct has_numinterfaces : std::false_type {};
+
+template<typename T>
+struct has_numinterfaces<T, std::void_t<decltype(std::declval<const T&>().bNumInterfaces.get())>>
+  : std::true_type {};
+}
+
+/** Number of unique interface numbers in a configuration, an interface with
+ *  alternate settings is counted once										 */
+template<typename Configuration>
+constexpr uint8_t numinterfaces_of(const Configuration& configuration) {
+	detail::interface_numbers numbers {};
+	detail::walk(numbers, configuration);
+	return static_cast<uint8_t>(numbers.count);
+}
+
+/**
+ * True if bNumInterfaces of a configuration matches the unique interface
+ * numbers in it.
+ * Usage:
+ *   static_assert(interfaces_counted(myConfiguration), "bNumInterfaces mismatch");
+ */
+template<typename Configuration>
+constexpr bool interfaces_counted(const Configuration& configuration) {
+	return configuration.bNumInterfaces.get() == numinterfaces_of(configuration);
+}
+
+namespace detail {
+/** True if bNumInterfaces of a configuration matches its interfaces, or if
+ *  the descriptor is not a configuration									 */
+template<typename Descriptor>
+constexpr bool counted(const Descriptor& descriptor) {
+	if constexpr( has_numinterfaces<Descriptor>::value )
+		return interfaces_counted(descriptor);
+	else
+		return true;
+}
+}
+
+/**
+ * Offsets of interface and endpoint descriptors in a configuration,
+ * computed at compile time, so that GET_DESCRIPTOR for an interface or an
+ * endpoint needs no parsing of the configuration.
+ * Usage:
+ *   using MyIndex = ConfigurationIndex<myConfiguration>;
+ *   const uint8_t* descriptor = MyIndex::interface(number, alternate);
+ */
+template<const auto& Config>
+class ConfigurationIndex {
+	static constexpr detail::interface_census census = detail::census_of(Config);
+	static_assert(census.count <= UINT8_MAX, "Too many interface descriptors in the configuration");
+	static_assert(detail::counted(Config), "bNumInterfaces mismatch, use count_interfaces");
+	using offsets_type = detail::configuration_offsets<census.count, census.numbers>;
+	static constexpr offsets_type offsets { Config };
+public:
+	/** Offset of the interface descriptor, or zero if there is none		 */
+	static constexpr unsigned interface_offset(unsigned number, unsigned alternate = 0) {
+		return offsets.find(number, alternate);
+	}
+	/** Offset of the endpoint descriptor, or zero if there is none		 */
+	static constexpr unsigned endpoint_offset(unsigned address) {
+		return offsets.endpoints[detail::endpoint_slot(address)];
+	}
+	/** Pointer to the interface descriptor, or nullptr if there is none	 */
+	static const uint8_t* interface(unsigned number, unsigned alternate = 0) {
+		const unsigned offset = interface_offset(number, alternate);
+		return offset ? Config.ptr() + offset : nullptr;
+	}
+	/** Pointer to the endpoint descriptor, or nullptr if there is none	 */
+	static const uint8_t* endpoint(unsigned address) {
+		const unsigned offset = endpoint_offset(address);
+		return offset ? Config.ptr() + offset : nullptr;
+	}
+	/** Number of interface descriptors, including alternate settings		 */
+	static constexpr unsigned count = census.count;
+};
+
+namespace detail {
+/** Numbers interfaces in order of appearance. An interface with a non-zero
+ *  alternate setting takes the number of the preceding interface, an
+ *  interface association starts at the number of the next interface		 */
+struct interface_numbering {
+	template<typename Association>
+	constexpr void association(Association& descriptor, unsigned) {
+		descriptor.bFirstInterface = InterfaceNumber(static_cast<InterfaceNumber::type>(next));
+	}
+	template<typename Interface>
+	constexpr void interface(Interface& descriptor, unsigned) {
+		if( descriptor.bAlternateSetting.get() == 0 || next == 0 ) ++next;
+		descriptor.bInterfaceNumber = InterfaceNumber(static_cast<InterfaceNumber::type>(next - 1));
+	}
+	template<typename Endpoint>
+	constexpr void endpoint(Endpoint&, unsigned) {}
+	unsigned next;
+};
+}
+
+/**
+ * Returns the configuration with bNumInterfaces, computed from the unique
+ * interface numbers, found in it.
+ * Usage:
+ *   constexpr auto myConfiguration = count_interfaces(MyConfiguration {
+ *     .bLength = {}, .bDescriptorType = {}, .wTotalLength = {},
+ *     .bNumInterfaces = 0, ... });
+ */
+template<typename Configuration>
+constexpr Configuration count_interfaces(Configuration configuration) {
+	configuration.bNumInterfaces =
+		decltype(configuration.bNumInterfaces)(numinterfaces_of(configuration));
+	return configuration;
+}
+
+/**
+ * Returns the configuration with interfaces numbered from zero in order of
+ * appearance, bFirstInterface of interface associations and bNumInterfaces
+ * set accordingly. An interface with a non-zero bAlternateSetting is an
+ * alternate setting of the preceding interface. Interface numbers, given in
+ * the initializer, are ignored. References to interfaces in class-specific
+ * descriptors, such as CDC Union, are not updated.
+ */
+template<typename Configuration>
+constexpr Configuration number_interfaces(Configuration configuration) {
+	detail::interface_numbering numbering {};
+	detail::walk(numbering, configuration);
+	return count_interfaces(configuration);
+}
+
+/*****************************************************************************/
+/*  Endpoint allocation 						 							 */
+/*****************************************************************************/
+
+namespace detail {
+/** Numbers endpoints of each direction from one in order of appearance.
+ *  The n-th endpoint of a direction in an alternate setting takes the number
+ *  of the n-th endpoint of that direction in the first setting of the
+ *  interface. Endpoints beyond the fifteenth take number zero and set
+ *  exhausted																 */
+struct endpoint_numbering {
+	template<typename Interface>
+	constexpr void interface(Interface& descriptor, unsigned) {
+		current = descriptor.bInterfaceNumber.get();
+		ordinals[0] = ordinals[1] = 0;
+	}
+	template<typename Endpoint>
+	constexpr void endpoint(Endpoint& descriptor, unsigned) {
+		const unsigned direction = descriptor.bEndpointAddress.get() >> 7;
+		const unsigned ordinal = ordinals[direction]++;
+		const unsigned key = current << 5 | direction << 4 | (ordinal & 0xF);
+		unsigned number = 0;
+		for(unsigned n = 0; n < count && number == 0 && ordinal < 16; ++n)
+			if( keys[n] == key ) number = numbers[n];
+		if( number == 0 && ordinal < 16 && count < endpoint_slots && next[direction] < 16 ) {
+			number = next[direction]++;
+			keys[count] = static_cast<uint16_t>(key);
+			numbers[count++] = static_cast<uint8_t>(number);
+		}
+		exhausted = exhausted || number == 0;
+		descriptor.bEndpointAddress = EndpointAddress(static_cast<EndpointAddress::type>(number),
+			static_cast<EndpointDirection_t>(direction));
+	}
+	unsigned current;
+	unsigned ordinals[2];
+	unsigned next[2] = { 1, 1 };
+	uint16_t keys[endpoint_slots];
+	uint8_t numbers[endpoint_slots];
+	unsigned count;
+	bool exhausted;
+};
+
+/** Not constexpr, so that a call to it fails constant evaluation			 */
+inline void run_out_of_endpoint_numbers() {}
+
+/** Largest payload per (micro)frame and transfer type of each endpoint
+ *  address, all transactions of a high-bandwidth endpoint are counted	 */
+struct endpoint_census {
+	template<typename Interface>
+	constexpr void interface(const Interface&, unsigned) {}
+	template<typename Endpoint>
+	constexpr void endpoint(const Endpoint& descriptor, unsigned) {
+		const unsigned address = descriptor.bEndpointAddress.get();
+		const unsigned slot = endpoint_slot(address);
+		const unsigned size = descriptor.wMaxPacketSize.bytes();
+		if( order[slot] == 0 ) {
+			order[slot] = static_cast<uint8_t>(++count);
+			addresses[count - 1] = static_cast<uint8_t>(address);
+		}
+		types[slot] = static_cast<uint8_t>(descriptor.bmAttributes.get() & 0b11);
+		sizes[slot] = static_cast<uint16_t>(size < sizes[slot] ? sizes[slot] : size);
+		numbered = numbered && (address & 0x0F) != 0;
+	}
+	uint8_t order[endpoint_slots];
+	uint8_t addresses[endpoint_slots];
+	uint8_t types[endpoint_slots];
+	uint16_t sizes[endpoint_slots];
+	unsigned count;
+	bool numbered = true;
+};
+
+template<typename Configuration>
+constexpr endpoint_census endpoint_census_of(const Configuration& configuration) {
+	endpoint_census census {};
+	walk(census, configuration);
+	return census;
+}
+
+constexpr unsigned align_up(unsigned value, unsigned alignment) {
+	return (value + alignment - 1) / alignment * alignment;
+}
+}
+
+/** Buffer of an endpoint in the packet memory. A double buffered endpoint
+ *  has its second buffer at offset + size									 */
+struct EndpointBuffer {
+	uint8_t address;
+	TransferType_t type;
+	uint8_t buffers;
+	uint16_t size;
+	uint16_t offset;
+};
+
+/**
+ * Numbers endpoints of the configuration in place, see
+ * detail::endpoint_numbering. Returns false if a direction has more than
+ * fifteen endpoints, those beyond take number zero. For run-time use.
+ * Usage:
+ *   if( ! try_number_endpoints(configuration) ) report(...);
+ */
+template<typename Configuration>
+constexpr bool try_number_endpoints(Configuration& configuration) {
+	detail::endpoint_numbering numbering {};
+	detail::walk(numbering, configuration);
+	return ! numbering.exhausted;
+}
+
+/**
+ * Returns the configuration with endpoints numbered, see
+ * detail::endpoint_numbering. Directions are kept as given. A configuration
+ * with more than fifteen endpoints of a direction fails to compile, this
+ * check works only in constant evaluation, at run time use
+ * try_number_endpoints.
+ * Usage:
+ *   constexpr auto myConfiguration = number_endpoints(MyConfiguration { ... });
+ */
+template<typename Configuration>
+constexpr Configuration number_endpoints(Configuration configuration) {
+	if( ! try_number_endpoints(configuration) ) detail::run_out_of_endpoint_numbers();
+	return configuration;
+}
+
+/**
+ * Layout of endpoint buffers in the packet memory (PMA, DPRAM, FIFO RAM),
+ * computed at compile time from the largest wMaxPacketSize of each endpoint
+ * address across alternate settings. Buffers are placed in order of first
+ * appearance, starting at Base, each aligned to Alignment. With
+ * DoubleBuffered, bulk and isochronous endpoints get two buffers. The
+ * layout must fit in Budget bytes of the packet memory.
+ * Usage:
+ *   using MyMemory = PacketMemory<myConfiguration, 512, 8, true, 64>;
+ *   for(const auto& buffer : MyMemory::table) setup(buffer);
+ *   const EndpointBuffer* in1 = MyMemory::find(0x81);
+ */
+template<const auto& Config, unsigned Budget, unsigned Alignment = 8,
+	bool DoubleBuffered = false, unsigned Base = 0>
+class PacketMemory {
+	static constexpr detail::endpoint_census census = detail::endpoint_census_of(Config);
+	static_assert(Alignment > 0, "Alignment must not be zero");
+	static_assert(census.numbered, "Endpoint number zero or run out of endpoint numbers");
+	static_assert(detail::counted(Config), "bNumInterfaces mismatch, use count_interfaces");
+	static constexpr unsigned buffers(unsigned slot) {
+		const auto type = static_cast<TransferType_t>(census.types[slot]);
+		return DoubleBuffered && (type == TransferType_t::Bulk || type == TransferType_t::Isochronous) ? 2 : 1;
+	}
+	struct layout_type {
+		EndpointBuffer entries[census.count ? census.count : 1];
+		unsigned end;
+	};
+	static constexpr layout_type make_layout() {
+		layout_type layout {};
+		unsigned offset = detail::align_up(Base, Alignment);
+		for(unsigned n = 0; n < census.count; ++n) {
+			const unsigned address = census.addresses[n];
+			const unsigned slot = detail::endpoint_slot(address);
+			const unsigned size = detail::align_up(census.sizes[slot], Alignment);
+			layout.entries[n] = { static_cast<uint8_t>(address),
+				static_cast<TransferType_t>(census.types[slot]),
+				static_cast<uint8_t>(buffers(slot)),
+				static_cast<uint16_t>(size), static_cast<uint16_t>(offset) };
+			offset += buffers(slot) * size;
+		}
+		layout.end = offset;
+		return layout;
+	}
+	static constexpr layout_type layout = make_layout();
+public:
+	/** Number of endpoint buffers, one per endpoint address				 */
+	static constexpr unsigned count = census.count;
+	/** Bytes of the packet memory used, including Base					 */
+	static constexpr unsigned size = layout.end;
+	static_assert(size <= Budget, "Endpoint buffers exceed the packet memory budget");
+	/** Endpoint buffers in order of their offsets							 */
+	static constexpr const EndpointBuffer (&table)[count ? count : 1] = layout.entries;
+	/** Buffer of the endpoint, or nullptr if there is none				 */
+	static constexpr const EndpointBuffer* find(unsigned address) {
+		const unsigned n = census.order[detail::endpoint_slot(address)];
+		return n && table[n - 1].address == address ? table + n - 1 : nullptr;
+	}
+};
+
+/*****************************************************************************/
+/*  Periodic bandwidth 						 								 */
+/*****************************************************************************/
+
+namespace detail {
+/** Bytes on the bus per (micro)frame, taken by one periodic endpoint:
+ *  payload of all transactions and protocol overhead, USB 2.0, 5.11.3.
+ *  Bit stuffing is not accounted for										 */
+constexpr unsigned periodic_bytes(BusSpeed_t speed, TransferType_t type, MaxPacketSize maxpacketsize) {
+	if( type != TransferType_t::Isochronous && type != TransferType_t::Interrupt ) return 0;
+	const bool iso = type == TransferType_t::Isochronous;
+	if( speed == BusSpeed_t::Full )
+		return maxpacketsize.size() + (iso ? 9u : 13u);
+	return maxpacketsize.transactions() * (maxpacketsize.size() + (iso ? 38u : 55u));
+}
+
+/** Periodic bytes per (micro)frame of each interface descriptor, assuming
+ *  all its periodic endpoints are scheduled in the same (micro)frame		 */
+template<unsigned Count>
+struct periodic_census {
+	template<typename Interface>
+	constexpr void interface(const Interface& descriptor, unsigned) {
+		settings[next++] = { descriptor.bInterfaceNumber.get(), descriptor.bAlternateSetting.get(), 0 };
+	}
+	template<typename Endpoint>
+	constexpr void endpoint(const Endpoint& descriptor, unsigned) {
+		if( next == 0 ) return;
+		settings[next - 1].bytes += periodic_bytes(speed,
+			static_cast<TransferType_t>(descriptor.bmAttributes.get() & 0b11),
+			descriptor.wMaxPacketSize);
+	}
+	struct setting {
+		unsigned number;
+		unsigned alternate;
+		unsigned bytes;
+	};
+	BusSpeed_t speed;
+	setting settings[Count ? Count : 1];
+	unsigned next;
+};
+}
+
+/**
+ * Periodic (isochronous and interrupt) bandwidth of a configuration,
+ * computed at compile time. The worst case is the sum over interfaces of
+ * the most demanding alternate setting, with all periodic endpoints
+ * scheduled in the same (micro)frame. bInterval does not lower the worst
+ * case, the host may schedule endpoints of any interval in one (micro)frame.
+ * The limit is 90% of a full speed frame or 80% of a high speed
+ * microframe, USB 2.0, 5.6.4 and 5.7.4.
+ * With Enforce, a configuration over the limit fails to compile.
+ * Usage:
+ *   using MyBandwidth = PeriodicBandwidth<myConfiguration, BusSpeed_t::High>;
+ *   static_assert(MyBandwidth::fits, "Too many audio channels");
+ */
+template<const auto& Config, BusSpeed_t Speed, bool Enforce = false>
+class PeriodicBandwidth {
+	static constexpr unsigned count = detail::census_of(Config).count;
+	static_assert(detail::counted(Config), "bNumInterfaces mismatch, use count_interfaces");
+	using census_type = detail::periodic_census<count>;
+	static constexpr census_type make_census() {
+		census_type census {};
+		census.speed = Speed;
+		detail::walk(census, Config);
+		return census;
+	}
+	static constexpr census_type census = make_census();
+	static constexpr unsigned make_worst() {
+		unsigned result = 0;
+		for(unsigned n = 0; n < count; ++n) {
+			unsigned first = n;
+			unsigned most = 0;
+			for(unsigned k = 0; k < count; ++k) {
+				if( census.settings[k].number != census.settings[n].number ) continue;
+				if( k < first ) first = k;
+				if( most < census.settings[k].bytes ) most = census.settings[k].bytes;
+			}
+			if( first == n ) result += most;
+		}
+		return result;
+	}
+public:
+	/** Bytes on the bus in a (micro)frame, available for periodic transfers */
+	static constexpr unsigned limit = Speed == BusSpeed_t::Full ? 1500 * 90 / 100 : 7500 * 80 / 100;
+	/** Worst case periodic bytes per (micro)frame							 */
+	static constexpr unsigned worst = make_worst();
+	static constexpr bool fits = worst <= limit;
+	static_assert(! Enforce || fits, "Periodic endpoints exceed the bandwidth limit");
+
+	/** Periodic bytes per (micro)frame of the alternate setting, zero if
+	 *  there is no such one													 */
+	static constexpr unsigned setting(unsigned number, unsigned alternate = 0) {
+		for(const auto& item : census.settings)
+			if( item.number == number && item.alternate == alternate ) return item.bytes;
+		return 0;
+	}
+};
+#endif
+
 /*****************************************************************************/
 /*  Helper entities 							 							 */
 /*****************************************************************************/
 
+namespace detail {
+/** Smallest power of two, not less than value								 */
+inline constexpr unsigned ceil2(unsigned value) {
+	unsigned result = 1;
+	while( result < value ) result *= 2;
+	return result;
+}
+
+/** Mixes bits of a 32-bit value											 */
+inline constexpr uint32_t mix(uint32_t value) {
+	value ^= value >> 16;
+	value *= 0x7FEB352Du;
+	value ^= value >> 15;
+	value *= 0x846CA68Bu;
+	value ^= value >> 16;
+	return value;
+}
+
+/** Perfect hash of language identifiers, built with the hash and displace
+ *  method: identifiers are spread over buckets, and every bucket gets the
+ *  displacement, that places its identifiers in free slots of the table	 */
+template<LanguageIdentifier ... List>
+struct language_hash {
+	static constexpr unsigned count = sizeof...(List);
+	static constexpr unsigned buckets = ceil2((count + 1) / 2);
+	static constexpr unsigned min_size = ceil2(2 * count);
+	static constexpr unsigned max_size = 16 * min_size;
+
+	static constexpr unsigned bucket(uint16_t key) {
+		return mix(key) & (buckets - 1);
+	}
+	static constexpr unsigned slot(uint16_t key, unsigned displacement, unsigned size) {
+		return mix(key | (displacement + 1) << 16) & (size - 1);
+	}
+	/** Finds displacements for a table of given size, largest buckets first,
+	 *  marks occupied slots. Returns false if there is no such displacements */
+	static constexpr bool place(unsigned size, uint8_t* displacements, bool* occupied) {
+		const uint16_t keys[] = { static_cast<uint16_t>(List) ..., 0 };
+		unsigned sizes[buckets] {};
+		for(unsigned i = 0; i < count; ++i)
+			++sizes[bucket(keys[i])];
+		for(unsigned n = count; n > 0; --n) {
+			for(unsigned b = 0; b < buckets; ++b) {
+				if( sizes[b] != n ) continue;
+				bool placed = false;
+				for(unsigned d = 0; d <= UINT8_MAX && ! placed; ++d) {
+					unsigned i = 0;
+					for(; i < count; ++i) {
+						if( bucket(keys[i]) != b ) continue;
+						const unsigned pos = slot(keys[i], d, size);
+						if( occupied[pos] ) break;
+						occupied[pos] = true;
+					}
+					placed = i == count;
+					if( placed ) {
+						displacements[b] = static_cast<uint8_t>(d);
+					} else {
+						for(unsigned j = 0; j < i; ++j)
+							if( bucket(keys[j]) == b ) occupied[slot(keys[j], d, size)] = false;
+					}
+				}
+				if( ! placed ) return false;
+			}
+		}
+		return true;
+	}
+	/** Smallest table size, the identifiers fit in, or zero if they do not */
+	static constexpr unsigned table_size() {
+		for(unsigned size = min_size; size <= max_size; size *= 2) {
+			uint8_t displacements[buckets] {};
+			bool occupied[max_size] {};
+			if( place(size, displacements, occupied) ) return size;
+		}
+		return 0;
+	}
+};
+
+/** Table of language identifiers, addressed by their perfect hash			 */
+template<LanguageIdentifier ... List>
+struct language_table {
+	using hash = language_hash<List...>;
+	static constexpr unsigned size = hash::table_size();
+	static_assert(size != 0, "Duplicate language identifiers");
+
+	constexpr language_table() : displacements {}, keys {}, indices {} {
+		const uint16_t items[] = { static_cast<uint16_t>(List) ..., 0 };
+		bool occupied[size] {};
+		hash::place(size, displacements, occupied);
+		for(unsigned i = 0; i < hash::count; ++i) {
+			const unsigned pos = hash::slot(items[i], displacements[hash::bucket(items[i])], size);
+			keys[pos] = items[i];
+			indices[pos] = static_cast<uint8_t>(i + 1);
+		}
+	}
+	/** Returns one-based index of lang, or zero if it is not in the table	 */
+	constexpr unsigned find(LanguageIdentifier lang) const {
+		const uint16_t key = static_cast<uint16_t>(lang);
+		const unsigned pos = hash::slot(key, displacements[hash::bucket(key)], size);
+		return keys[pos] == key ? indices[pos] : 0;
+	}
+	uint8_t displacements[hash::buckets];
+	uint16_t keys[size];
+	uint8_t indices[size];
+};
+}
+
 /** List of Language identifiers,
  *  Used to build string descriptor zero and for multilingual strings		 */
 template<LanguageIdentifier ... List>
 struct LanguageList {
 	static constexpr unsigned count = sizeof...(List);
+	static_assert(count <= UINT8_MAX, "Too many languages");
 	using type = usb1::Languages<count>;
 	static constexpr type list() {
 		return { {}, {}, { List ... } };
@@ -1059,23 +2209,142 @@ struct LanguageList {
 	static constexpr unsigned indexof(LanguageIdentifier lang) {
 		return detail::index<LanguageIdentifier, List...>::of(lang);
 	}
+	/** Returns the same as indexof, with a perfect hash lookup in constant
+	 *  time, regardless of count of languages								 */
+	static constexpr unsigned lookup(LanguageIdentifier lang) {
+		return table.find(lang);
+	}
+	static constexpr detail::language_table<List...> table {};
 };
 
+/* storage allocation														*/
+template<LanguageIdentifier ... List>
+constexpr detail::language_table<List...> LanguageList<List...>::table;
+
+/** Number of characters, needed to encode size bytes in hex				 */
+constexpr unsigned hex_length(unsigned size) { return 2 * size; }
+
+/** Number of characters, needed to encode size bytes in base32, no padding */
+constexpr unsigned base32_length(unsigned size) { return (8 * size + 4) / 5; }
+
 /**
- * usb1::String wrapper for accessing the descriptor via a getter
+ * String descriptor, composed at run time in a statically allocated buffer
+ * of Capacity characters, such as a serial number made of a chip UID.
+ * Since C++17 Strings and MultiStrings accept a pointer to a StringSlot
+ * in place of a string and return the prepared descriptor as is.
+ * Usage:
+ *   StringSlot<hex_length(12)> serial;
+ *   using MyStrings = Strings<lang, sManufacturer, sProduct, &serial>;
+ *   serial.hex(uid, 12);
  */
-template<ustring Source>
-struct StringItem {
+template<unsigned Capacity>
+class StringSlot {
+	static_assert(Capacity <= max_string_length, "String is too long");
+public:
+	constexpr StringSlot() : bytes { 2, static_cast<uint8_t>(DescriptorType_t::STRING) } {}
+	constexpr const uint8_t* ptr() const { return bytes; }
+	/** Number of characters in the string									 */
+	unsigned size() const { return (bytes[0] - 2u) / 2; }
+
+	/** Copies str, truncating it to Capacity								 */
+	void assign(ustring_view str) {
+		const unsigned len = str.size < Capacity ? str.size : Capacity;
+		for(unsigned i = 0; i < len; ++i)
+			put(i, str.data[i]);
+		resize(len);
+	}
+	/** Encodes data as upper case hex digits, most significant nibble first,
+	 *  truncating it to Capacity											 */
+	void hex(const uint8_t* data, unsigned size) {
+		constexpr char16_t digits[] = u"0123456789ABCDEF";
+		unsigned len = 0;
+		for(unsigned i = 0; i < size && len + 2 <= Capacity; ++i) {
+			put(len++, digits[data[i] >> 4]);
+			put(len++, digits[data[i] & 0xF]);
+		}
+		resize(len);
+	}
+	/** Encodes data in RFC 4648 base32 alphabet without padding,
+	 *  truncating it to Capacity											 */
+	void base32(const uint8_t* data, unsigned size) {
+		constexpr char16_t digits[] = u"ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+		unsigned len = 0;
+		unsigned buffer = 0;
+		unsigned bits = 0;
+		for(unsigned i = 0; i < size && len < Capacity; ++i) {
+			buffer = (buffer << 8 | data[i]) & 0xFFF;
+			bits += 8;
+			while( bits >= 5 && len < Capacity ) {
+				bits -= 5;
+				put(len++, digits[(buffer >> bits) & 0x1F]);
+			}
+		}
+		if( bits > 0 && len < Capacity )
+			put(len++, digits[(buffer << (5 - bits)) & 0x1F]);
+		resize(len);
+	}
+private:
+	void put(unsigned pos, char16_t c) {
+		bytes[2 + 2 * pos] = static_cast<uint8_t>(c & 0xFF);
+		bytes[3 + 2 * pos] = static_cast<uint8_t>(c >> 8);
+	}
+	void resize(unsigned len) {
+		bytes[0] = static_cast<uint8_t>(2 + 2 * len);
+	}
+	uint8_t bytes[2 + 2 * Capacity];
+};
+
+template<unsigned A, unsigned B>
+constexpr bool same_string(const StringSlot<A>* a, const StringSlot<B>* b) {
+	return static_cast<const void*>(a) == static_cast<const void*>(b);
+}
+template<unsigned Capacity>
+constexpr bool same_string(const StringSlot<Capacity>*, ustring_view) { return false; }
+template<unsigned Capacity>
+constexpr bool same_string(ustring_view, const StringSlot<Capacity>*) { return false; }
+
+namespace detail {
+/** A string to be turned into a descriptor at compile time, or a descriptor,
+ *  prepared at run time													 */
+struct string_source {
+	ustring_view text;
+	const uint8_t* descriptor;
+};
+
+inline constexpr string_source source_of(ustring_view text) {
+	return { text, nullptr };
+}
+template<unsigned Capacity>
+constexpr string_source source_of(const StringSlot<Capacity>* slot) {
+	return { { nullptr, 0 }, slot->ptr() };
+}
+
+template<typename Type, Type Source>
+struct string_item {
 	static const uint8_t* get() {
 		static constexpr usb1::String<Source> source;
 		return source.ptr();
 	}
 };
 
+template<unsigned Capacity, StringSlot<Capacity>* Slot>
+struct string_item<StringSlot<Capacity>*, Slot> {
+	static const uint8_t* get() {
+		return Slot->ptr();
+	}
+};
+}
+
+/**
+ * usb1::String wrapper for accessing the descriptor via a getter
+ */
+template<USBPLUSPLUS_STRING Source>
+struct StringItem : detail::string_item<decltype(Source), Source> {};
+
 /**
  *  Monolingual dictionary of string descriptors
  */
-template<LanguageIdentifier LangID, ustring ... List>
+template<LanguageIdentifier LangID, USBPLUSPLUS_STRING ... List>
 class Strings {
 	static const uint8_t* getlangs() {
 		static const typename LanguageList<LangID>::type languages = 
@@ -1084,7 +2353,8 @@ class Strings {
 	}
 public:
 	/** Returns one-based index of str, for use in descriptor definitions 	 */
-	static constexpr unsigned indexof(ustring str) {
+	template<typename String>
+	static constexpr unsigned indexof(const String& str) {
 		return list<List...>::indexof(str);
 	}
 	static constexpr Index::type count = sizeof...(List);
@@ -1103,6 +2373,183 @@ public:
 
 };
 
+namespace detail {
+/** Size of String Descriptor Zero with one language and string descriptors */
+template<USBPLUSPLUS_STRING ... List>
+constexpr unsigned packed_size() {
+	const unsigned lengths[] = { 0u, ustring_view(List).size ... };
+	unsigned size = 4;
+	for(unsigned i = 1; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+		size += 2 + 2 * lengths[i];
+	return size;
+}
+
+/** Writes string descriptor of str at data[pos], returns position past it */
+inline constexpr unsigned put_string(uint8_t* data, unsigned pos, ustring_view str) {
+	data[pos++] = static_cast<uint8_t>(2 + 2 * str.size);
+	data[pos++] = static_cast<uint8_t>(DescriptorType_t::STRING);
+	for(unsigned i = 0; i < str.size; ++i) {
+		data[pos++] = static_cast<uint8_t>(str.data[i] & 0xFF);
+		data[pos++] = static_cast<uint8_t>(str.data[i] >> 8);
+	}
+	return pos;
+}
+
+/** String Descriptor Zero, followed by string descriptors, packed into one
+ *  contiguous block, and one-based offsets of the descriptors in the block */
+template<LanguageIdentifier LangID, USBPLUSPLUS_STRING ... List>
+struct string_table {
+	static constexpr unsigned count = sizeof...(List);
+	static constexpr unsigned size = packed_size<List...>();
+	static_assert(size <= UINT16_MAX, "Strings are too long for the string table");
+
+	constexpr string_table() : data {}, offsets {} {
+		const ustring_view sources[] = { ustring_view(List) ..., {nullptr, 0} };
+		unsigned pos = 0;
+		data[pos++] = 4;
+		data[pos++] = static_cast<uint8_t>(DescriptorType_t::STRING);
+		data[pos++] = static_cast<uint8_t>(static_cast<unsigned>(LangID) & 0xFF);
+		data[pos++] = static_cast<uint8_t>(static_cast<unsigned>(LangID) >> 8);
+		for(unsigned i = 0; i < count; ++i) {
+			offsets[i + 1] = static_cast<uint16_t>(pos);
+			pos = put_string(data, pos, sources[i]);
+		}
+	}
+	uint8_t data[size];
+	uint16_t offsets[count + 1];
+};
+}
+
+/**
+ *  Monolingual dictionary of string descriptors, stored in one contiguous
+ *  block. A lookup is a bounds check and an offset, no per-string objects
+ */
+template<LanguageIdentifier LangID, USBPLUSPLUS_STRING ... List>
+class PackedStrings {
+	using table_type = detail::string_table<LangID, List...>;
+	static constexpr table_type table {};
+public:
+	/** Returns one-based index of str, for use in descriptor definitions 	 */
+	template<typename String>
+	static constexpr unsigned indexof(const String& str) {
+		return list<List...>::indexof(str);
+	}
+	static constexpr Index::type count = sizeof...(List);
+	static constexpr LanguageIdentifier lang = LangID;
+
+	/** Returns pointer to a string descriptor, including String Descriptor Zero
+	 * LanguageIdentifier is ignored										 */
+	static const uint8_t* get(Index::type index, LanguageIdentifier = LangID) {
+		return index > count ? nullptr : table.data + table.offsets[index];
+	}
+};
+
+/* storage allocation														*/
+template<LanguageIdentifier LangID, USBPLUSPLUS_STRING ... List>
+constexpr typename PackedStrings<LangID, List...>::table_type PackedStrings<LangID, List...>::table;
+
+namespace detail {
+/** String parameters of a monolingual dictionary							 */
+template<typename Dictionary>
+struct dictionary_strings;
+
+template<template<LanguageIdentifier, USBPLUSPLUS_STRING ...> class Dictionary,
+	LanguageIdentifier LangID, USBPLUSPLUS_STRING ... List>
+struct dictionary_strings<Dictionary<LangID, List...>> {
+	static constexpr string_source items[] = { source_of(List) ..., { { nullptr, 0 }, nullptr } };
+};
+
+/* storage allocation														*/
+template<template<LanguageIdentifier, USBPLUSPLUS_STRING ...> class Dictionary,
+	LanguageIdentifier LangID, USBPLUSPLUS_STRING ... List>
+constexpr string_source dictionary_strings<Dictionary<LangID, List...>>::items[];
+
+/** Layout of the pool of unique strings of several monolingual dictionaries.
+ *  Strings are numbered language by language, n = language * count + index */
+template<typename ... Lists>
+struct string_pool_layout {
+	static constexpr unsigned languages = sizeof...(Lists);
+	static constexpr unsigned count = first<Lists...>::type::count;
+	static constexpr unsigned strings = languages * count;
+
+	static constexpr string_source source(unsigned n) {
+		const string_source* items[] = { dictionary_strings<Lists>::items ... };
+		return items[n / count][n % count];
+	}
+	static constexpr bool runtime(unsigned n) {
+		return source(n).descriptor != nullptr;
+	}
+	/** Number of the first string with the same content, or the same
+	 *  run time descriptor, as string n									 */
+	static constexpr unsigned first_of(unsigned n) {
+		for(unsigned k = 0; k < n; ++k) {
+			if( runtime(k) != runtime(n) ) continue;
+			if( runtime(n) ? source(k).descriptor == source(n).descriptor
+			               : equal(source(k).text, source(n).text) ) return k;
+		}
+		return n;
+	}
+	/** Number of unique strings, either compile time or run time			 */
+	static constexpr unsigned unique(bool runtime_only) {
+		unsigned result = 0;
+		for(unsigned n = 0; n < strings; ++n)
+			if( first_of(n) == n && runtime(n) == runtime_only ) ++result;
+		return result;
+	}
+	/** Size of compile time string descriptors, all or unique only		 */
+	static constexpr unsigned size(bool unique_only) {
+		unsigned result = 0;
+		for(unsigned n = 0; n < strings; ++n)
+			if( ! runtime(n) && (! unique_only || first_of(n) == n) )
+				result += 2 + 2 * source(n).text.size;
+		return result;
+	}
+};
+
+/** Pool of unique string descriptors with per-language maps of indices
+ *  to the pool slots														 */
+template<typename ... Lists>
+struct string_pool {
+	using layout = string_pool_layout<Lists...>;
+	static constexpr unsigned count = layout::count;
+	static constexpr unsigned unique = layout::unique(false);
+	static constexpr unsigned runtime = layout::unique(true);
+	static constexpr unsigned size = layout::size(true);
+	static constexpr unsigned bytes_saved = layout::size(false) - size;
+	static_assert(count > 0, "Strings are empty");
+	static_assert(unique + runtime <= UINT8_MAX, "Too many unique strings for the string pool");
+	static_assert(size <= UINT16_MAX, "Strings are too long for the string pool");
+
+	constexpr string_pool() : slots {}, offsets {}, descriptors {}, data {} {
+		unsigned next = 0;
+		unsigned next_runtime = 0;
+		unsigned pos = 0;
+		for(unsigned n = 0; n < layout::strings; ++n) {
+			const unsigned first = layout::first_of(n);
+			if( first != n ) {
+				slots[n / count][n % count] = slots[first / count][first % count];
+			} else if( layout::runtime(n) ) {
+				descriptors[next_runtime] = layout::source(n).descriptor;
+				slots[n / count][n % count] = static_cast<uint8_t>(unique + next_runtime++);
+			} else {
+				offsets[next] = static_cast<uint16_t>(pos);
+				pos = put_string(data, pos, layout::source(n).text);
+				slots[n / count][n % count] = static_cast<uint8_t>(next++);
+			}
+		}
+	}
+	const uint8_t* get(unsigned language, unsigned index) const {
+		const unsigned slot = slots[language][index];
+		return slot < unique ? data + offsets[slot] : descriptors[slot - unique];
+	}
+	uint8_t slots[layout::languages][count];
+	uint16_t offsets[unique];
+	/* run time descriptors, one extra element to avoid zero-length array	 */
+	const uint8_t* descriptors[runtime + 1];
+	uint8_t data[size];
+};
+}
+
 /** Multilingual dictionary of string resources.
  *  Usage: MultiStrings<Strings<lang1, ustring ...> ...>
  *  All Strings are expected to have the same number of ustring
@@ -1110,6 +2557,8 @@ public:
 template<typename ... Lists>
 class MultiStrings {
 	using Langs = LanguageList<Lists::lang...>;
+	using pool_type = detail::string_pool<Lists...>;
+	static constexpr pool_type pool {};
 	static const uint8_t* getlangs() {
 		static constexpr const typename Langs::type languages = Langs::list();
 		return languages.ptr();
@@ -1118,29 +2567,240 @@ public:
 	static constexpr unsigned count = detail::first<Lists...>::type::count;
 	static_assert(Langs::count == sizeof...(Lists),
 			"Count of languages mismatches count of strings");
+	static_assert(detail::all_of(Lists::count == count ...),
+			"Count of strings mismatches across languages");
+	/** Size of string descriptors, not stored due to identical strings being
+	 *  pooled across languages												 */
+	static constexpr unsigned bytes_saved = pool_type::bytes_saved;
 
 	/** Returns one-based index of str in the first list.
 	 *  For use in descriptor definitions 	 								 */
-	static constexpr unsigned indexof(ustring str) {
+	template<typename String>
+	static constexpr unsigned indexof(const String& str) {
 		return detail::first<Lists...>::type::indexof(str);
 	}
 
 	/** Returns pointer to a string descriptor, including String Descriptor Zero
 	 * LanguageIdentifier is looked up in the Langs. If not found, */
 	static const uint8_t* get(Index::type index, LanguageIdentifier lang) {
-		static constexpr detail::mstring_getter items[] {
-			Lists::get ...
-		};
 		if( index > count ) return nullptr;
 		if( index == 0 ) return getlangs();  /* String Descriptor Zero		 */
-		unsigned pos = Langs::indexof(lang); /* one-based index 			 */
+		unsigned pos = Langs::lookup(lang);  /* one-based index 			 */
 		if( pos ) --pos; /* if not found, the first language is used		 */
-		return items[pos](index, lang);
+		return pool.get(pos, index - 1u);
 	}
 };
 
+/* storage allocation														*/
+template<typename ... Lists>
+constexpr typename MultiStrings<Lists...>::pool_type MultiStrings<Lists...>::pool;
+
+#if __cplusplus >= 201703L
+/** Bytes of a descriptor, found in a DeviceImage							 */
+struct DescriptorSpan {
+	const uint8_t* data;
+	uint16_t size;
+	constexpr bool empty() const { return data == nullptr; }
+};
+
+namespace detail {
+/** Languages and the pool layout of a dictionary of strings				 */
+template<typename Dictionary>
+struct image_strings {
+	using layout = string_pool_layout<Dictionary>;
+	static constexpr LanguageIdentifier langs[] = { Dictionary::lang };
+};
+
+template<typename ... Lists>
+struct image_strings<MultiStrings<Lists...>> {
+	using layout = string_pool_layout<Lists...>;
+	static constexpr LanguageIdentifier langs[] = { Lists::lang ... };
+};
+
+/** String Descriptor Zero, followed by unique compile time strings		 */
+template<typename Dictionary>
+struct __attribute__((__packed__))
+image_string_block {
+	using layout = typename image_strings<Dictionary>::layout;
+	static constexpr unsigned zero_size = 2 + 2 * layout::languages;
+	static constexpr unsigned size = zero_size + layout::size(true);
+
+	/** Position of string n in data or, if it is composed at run time, its
+	 *  number among run time strings										 */
+	static constexpr unsigned position(unsigned n) {
+		const unsigned first = layout::first_of(n);
+		unsigned pos = zero_size;
+		unsigned number = 0;
+		for(unsigned k = 0; k < first; ++k) {
+			if( layout::first_of(k) != k ) continue;
+			if( layout::runtime(k) ) ++number;
+			else pos += 2 + 2 * layout::source(k).text.size;
+		}
+		return layout::runtime(first) ? number : pos;
+	}
+
+	constexpr image_string_block() : data {} {
+		data[0] = static_cast<uint8_t>(zero_size);
+		data[1] = static_cast<uint8_t>(DescriptorType_t::STRING);
+		for(unsigned i = 0; i < layout::languages; ++i) {
+			const auto lang = static_cast<unsigned>(image_strings<Dictionary>::langs[i]);
+			data[2 + 2 * i] = static_cast<uint8_t>(lang & 0xFF);
+			data[3 + 2 * i] = static_cast<uint8_t>(lang >> 8);
+		}
+		for(unsigned n = 0; n < layout::strings; ++n)
+			if( layout::first_of(n) == n && ! layout::runtime(n) )
+				put_string(data, position(n), layout::source(n).text);
+	}
+	uint8_t data[size];
+};
+
+/** Descriptors of strings, composed at run time, in order of first use	 */
+template<typename Dictionary>
+struct image_runtime {
+	using layout = typename image_strings<Dictionary>::layout;
+	constexpr image_runtime() : descriptors {} {
+		unsigned next = 0;
+		for(unsigned n = 0; n < layout::strings; ++n)
+			if( layout::first_of(n) == n && layout::runtime(n) )
+				descriptors[next++] = layout::source(n).descriptor;
+	}
+	/* one extra element to avoid zero-length array							 */
+	const uint8_t* descriptors[layout::unique(true) + 1];
+};
+
+/** Key of a descriptor in the table of a DeviceImage						 */
+constexpr uint32_t image_key(unsigned type, unsigned index, unsigned lang) {
+	return static_cast<uint32_t>(type << 24 | index << 16 | lang);
+}
+
+/** Descriptor in a DeviceImage, or, if length is zero, a run time string,
+ *  offset is then its number among run time strings						 */
+struct image_entry {
+	uint32_t key;
+	uint16_t offset;
+	uint16_t length;
+};
+
+/** Entries of a DeviceImage, sorted by key									 */
+template<unsigned Count>
+struct image_table {
+	/** Returns the entry, matching key, or nullptr							 */
+	constexpr const image_entry* find(uint32_t key) const {
+		unsigned lo = 0;
+		unsigned hi = Count;
+		while( lo < hi ) {
+			const unsigned mid = (lo + hi) / 2;
+			if( entries[mid].key < key ) lo = mid + 1;
+			else hi = mid;
+		}
+		return lo < Count && entries[lo].key == key ? entries + lo : nullptr;
+	}
+	constexpr void sort() {
+		for(unsigned i = 1; i < Count; ++i)
+			for(unsigned j = i; j > 0 && entries[j].key < entries[j - 1].key; --j) {
+				const image_entry entry = entries[j];
+				entries[j] = entries[j - 1];
+				entries[j - 1] = entry;
+			}
+	}
+	image_entry entries[Count];
+};
+}
+
+/**
+ * All descriptors of a device, laid out back to back in one constant blob,
+ * aligned to a cache line, with a table of (type, index, langid) to
+ * (offset, length). A GET_DESCRIPTOR request is served with one lookup.
+ * Descriptors are indexed by their order among descriptors of the same type.
+ * Usage:
+ *   using MyImage = DeviceImage<MyStrings, myDevice, myQualifier, myConfig>;
+ *   DescriptorSpan span = MyImage::get(request.wValue, request.wIndex);
+ */
+template<typename Strings, const auto& Device, const auto& ... Descriptors>
+class DeviceImage {
+	using strings_type = detail::image_string_block<Strings>;
+	using layout = typename strings_type::layout;
+	using descriptors_type = typename List<std::remove_cv_t<std::remove_reference_t<decltype(Device)>>,
+		std::remove_cv_t<std::remove_reference_t<decltype(Descriptors)>> ...>::type;
+	struct __attribute__((__packed__))
+	image_type {
+		descriptors_type descriptors;
+		strings_type strings;
+	};
+	static constexpr unsigned descriptor_count = 1 + sizeof...(Descriptors);
+public:
+	static constexpr unsigned alignment = 64;
+	static constexpr unsigned size = sizeof(image_type);
+	/** Number of descriptors, strings counted per language				 */
+	static constexpr unsigned count = descriptor_count + 1 + layout::strings;
+	static_assert(size <= UINT16_MAX, "Descriptors are too long for the device image");
+	static_assert((detail::counted(Descriptors) && ...), "bNumInterfaces mismatch, use count_interfaces");
+
+	/** Returns the descriptor, or an empty span if there is no such one.
+	 *  The language is ignored for descriptors other than strings, and for
+	 *  a string, not found in the language, the first language is used	 */
+	static DescriptorSpan get(DescriptorType_t type, uint8_t index, LanguageIdentifier lang = {}) {
+		const bool string = type == DescriptorType_t::STRING && index != 0;
+		const auto key = detail::image_key(static_cast<unsigned>(type), index,
+			string ? static_cast<unsigned>(lang) : 0u);
+		const detail::image_entry* entry = table.find(key);
+		if( entry == nullptr && string )
+			entry = table.find(detail::image_key(static_cast<unsigned>(type), index,
+				static_cast<unsigned>(detail::image_strings<Strings>::langs[0])));
+		if( entry == nullptr ) return { nullptr, 0 };
+		if( entry->length == 0 ) return { runtime.descriptors[entry->offset], runtime.descriptors[entry->offset][0] };
+		return { data() + entry->offset, entry->length };
+	}
+	/** Returns the descriptor, requested with GET_DESCRIPTOR				 */
+	static DescriptorSpan get(uint16_t wValue, uint16_t wIndex) {
+		return get(static_cast<DescriptorType_t>(wValue >> 8), static_cast<uint8_t>(wValue & 0xFF),
+			static_cast<LanguageIdentifier>(wIndex));
+	}
+	static const uint8_t* data() { return reinterpret_cast<const uint8_t*>(&image); }
+private:
+	static constexpr detail::image_table<count> make_table() {
+		detail::image_table<count> result {};
+		const unsigned types[] = { static_cast<unsigned>(Device.descriptortype()),
+			static_cast<unsigned>(Descriptors.descriptortype()) ... };
+		const unsigned sizes[] = { sizeof(Device), sizeof(Descriptors) ... };
+		unsigned offset = 0;
+		for(unsigned i = 0; i < descriptor_count; ++i) {
+			unsigned index = 0;
+			for(unsigned k = 0; k < i; ++k)
+				index += types[k] == types[i];
+			result.entries[i] = { detail::image_key(types[i], index, 0),
+				static_cast<uint16_t>(offset), static_cast<uint16_t>(sizes[i]) };
+			offset += sizes[i];
+		}
+		const unsigned string = static_cast<unsigned>(DescriptorType_t::STRING);
+		result.entries[descriptor_count] = { detail::image_key(string, 0, 0),
+			static_cast<uint16_t>(offset), static_cast<uint16_t>(strings_type::zero_size) };
+		for(unsigned n = 0; n < layout::strings; ++n) {
+			const auto source = layout::source(layout::first_of(n));
+			const auto lang = static_cast<unsigned>(detail::image_strings<Strings>::langs[n / layout::count]);
+			const unsigned position = strings_type::position(n);
+			result.entries[descriptor_count + 1 + n] = { detail::image_key(string, n % layout::count + 1, lang),
+				static_cast<uint16_t>(layout::runtime(n) ? position : offset + position),
+				static_cast<uint16_t>(layout::runtime(n) ? 0 : 2 + 2 * source.text.size) };
+		}
+		result.sort();
+		return result;
+	}
+	alignas(alignment) static constexpr image_type image { { Device, Descriptors ... }, {} };
+	static constexpr detail::image_table<count> table = make_table();
+	static constexpr detail::image_runtime<Strings> runtime {};
+};
+#endif
+
 //9.4 Standard Device Requests
 struct StandardDeviceRequest : usb1::SetupPacket {
+	// 9.3.1 bmRequestType
+	constexpr RequestType_t request_type() const noexcept {
+		return RequestType_t(bmRequestType.get() & static_cast<uint8_t>(RequestType_t::__mask));
+	}
+	constexpr Recipient_t recipient() const noexcept {
+		return Recipient_t(bmRequestType.get() & static_cast<uint8_t>(Recipient_t::__mask));
+	}
 	// 9.4.3 Get Descriptor
 	DescriptorType_t descriptor_type() const noexcept {
 		// The wValue field specifies the descriptor type in the high byte (refer to Table 9-5)
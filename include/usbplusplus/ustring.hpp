@@ -34,73 +34,182 @@
  */
 
 namespace usbplusplus {
-constexpr unsigned ustring_size = 64; /* increasing this requires adding
-										explicit specializations to utf16le */
+constexpr unsigned ustring_size = 64; /* size of ustring buffer, strings of
+										other lengths can be fixed_string	*/
+
+/** Longest string, fitting in a string descriptor (bLength is 8-bit) 		*/
+constexpr unsigned max_string_length = 126;
 
 /** Simple unicode string for easy of use									*/
 using ustring = const char16_t[ustring_size];
 
-inline constexpr unsigned length_impl(ustring s, unsigned pos) {
-	return (pos < ustring_size && s[pos]) ? length_impl(s, pos+1) : pos;
-}
 inline constexpr unsigned length(ustring s) {
-	return length_impl(s,0);
+	unsigned pos = 0;
+	while( pos < ustring_size && s[pos] ) ++pos;
+	return pos;
 }
 
-inline constexpr bool equal_impl(ustring a, ustring b, unsigned pos) {
-	return  ( pos < ustring_size && a[pos] == b[pos] )
-			? equal_impl(a,b,pos+1)
-			: pos == ustring_size;
+inline constexpr bool equal(ustring a, ustring b) {
+	for(unsigned pos = 0; pos < ustring_size; ++pos) {
+		if( a[pos] != b[pos] ) return false;
+		if( ! a[pos] ) return true;
+	}
+	return true;
 }
 
-inline constexpr bool equal(ustring a, ustring b) {
-	return equal_impl(a,b,0);
+/** Characters and length of a ustring or a fixed_string					*/
+struct ustring_view {
+	constexpr ustring_view(ustring s) : data(s), size(length(s)) {}
+	constexpr ustring_view(const char16_t* s, unsigned n) : data(s), size(n) {}
+	const char16_t* data;
+	unsigned size;
+};
+
+inline constexpr bool equal(ustring_view a, ustring_view b) {
+	if( a.size != b.size ) return false;
+	for(unsigned pos = 0; pos < a.size; ++pos)
+		if( a.data[pos] != b.data[pos] ) return false;
+	return true;
+}
+
+inline constexpr bool same_string(ustring_view a, ustring_view b) {
+	return equal(a, b);
 }
 
+#if __cplusplus >= 202002L
+/** String of the literal's length, usable as a template parameter.
+ *  Usage: constexpr fixed_string sProduct = u"SuperPuper device";			*/
+template<unsigned N>
+struct fixed_string {
+	static_assert(N - 1 <= max_string_length, "String is too long");
+	char16_t value[N];
+	constexpr fixed_string(const char16_t (&src)[N]) : value {} {
+		for(unsigned i = 0; i < N; ++i) value[i] = src[i];
+	}
+	static constexpr unsigned size() { return N - 1; }
+	constexpr operator ustring_view() const { return { value, size() }; }
+};
+
+/** UTF-8 string literal, the template parameter of operator ""_u16		*/
+template<unsigned N>
+struct utf8_literal {
+	char8_t value[N];
+	constexpr utf8_literal(const char (&src)[N]) : value {} {
+		for(unsigned i = 0; i < N; ++i) value[i] = static_cast<char8_t>(src[i]);
+	}
+	constexpr utf8_literal(const char8_t (&src)[N]) : value {} {
+		for(unsigned i = 0; i < N; ++i) value[i] = src[i];
+	}
+	static constexpr unsigned size() { return N - 1; }
+};
+
+namespace detail {
+/** Not constexpr by intent, so that decoding of an invalid UTF-8 sequence
+ *  is not a constant expression and fails to compile						*/
+void invalid_utf8_sequence();
+
+/** Decodes UTF-8 sequence at pos, advances pos past it						*/
+constexpr char32_t decode_utf8(const char8_t* src, unsigned size, unsigned& pos) {
+	const unsigned lead = src[pos++];
+	if( lead < 0x80 ) return lead;
+	const unsigned tail = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : 1;
+	if( lead < 0xC2 || lead > 0xF4 || pos + tail > size ) invalid_utf8_sequence();
+	char32_t result = lead & (0x3Fu >> tail);
+	for(unsigned i = 0; i < tail; ++i) {
+		const unsigned next = src[pos++];
+		if( (next & 0xC0) != 0x80 ) invalid_utf8_sequence();
+		result = result << 6 | (next & 0x3F);
+	}
+	const char32_t shortest[] = { 0, 0x80, 0x800, 0x10000 };
+	if( result < shortest[tail] || result > 0x10FFFF || (result >= 0xD800 && result <= 0xDFFF) )
+		invalid_utf8_sequence();
+	return result;
+}
+
+/** Number of UTF-16 code units, needed for the UTF-8 string				*/
+template<unsigned N>
+consteval unsigned utf16_length(const utf8_literal<N>& src) {
+	unsigned length = 0;
+	for(unsigned pos = 0; pos < src.size(); )
+		length += decode_utf8(src.value, src.size(), pos) < 0x10000 ? 1u : 2u;
+	return length;
+}
+}
+
+/** Transcodes UTF-8 literal to fixed_string at compile time,
+ *  code points above U+FFFF become surrogate pairs.
+ *  Usage: constexpr auto sProduct = u8"СуперПупер пристрій"_u16;			*/
+template<utf8_literal Source>
+consteval auto operator ""_u16() {
+	constexpr unsigned length = detail::utf16_length(Source);
+	char16_t result[length + 1] {};
+	unsigned pos = 0;
+	for(unsigned i = 0; i < length; ) {
+		const char32_t code = detail::decode_utf8(Source.value, Source.size(), pos);
+		if( code < 0x10000 ) {
+			result[i++] = static_cast<char16_t>(code);
+		} else {
+			result[i++] = static_cast<char16_t>(0xD800 + ((code - 0x10000) >> 10));
+			result[i++] = static_cast<char16_t>(0xDC00 + ((code - 0x10000) & 0x3FF));
+		}
+	}
+	return fixed_string<length + 1>(result);
+}
+#endif
+
+/** Type of string template parameters, ustring, or, since C++17, also
+ *  fixed_string. Use ustring_view(param) to access the string				*/
+#if __cplusplus >= 201703L
+#define USBPLUSPLUS_STRING auto
+#else
+#define USBPLUSPLUS_STRING ustring
+#endif
+
 /** UTF-16LE packed string of known length N								*/
 template<unsigned N>
 struct utf16le {
 	using type = char16_t[N];
 	const type value;
-	constexpr utf16le(ustring src) : utf16le{src, std::make_index_sequence<N>()} {
-		static_assert(N < sizeof(ustring),"String is too long");
+	constexpr utf16le(ustring_view src) : utf16le{src, std::make_index_sequence<N>()} {
+		static_assert(N <= max_string_length, "String is too long");
 	}
 private:
 	template<std::size_t ... I>
-	constexpr utf16le(ustring src, std::index_sequence<I...>) : value { byteorder<>::le(src[I]) ... } { }
+	constexpr utf16le(ustring_view src, std::index_sequence<I...>) : value { byteorder<>::le(src.data[I]) ... } { }
 };
 
-/** converts char16_t[64] to string of necessary length						*/
-template<ustring String>
+/** converts a string template parameter to string of necessary length		*/
+template<USBPLUSPLUS_STRING String>
 struct cstring {
 	/* static constexpr ustring value = String; // does not work */
-	static constexpr unsigned length = usbplusplus::length(String);
-	static constexpr utf16le<length> string = {String};
+	static constexpr unsigned length = ustring_view(String).size;
+	static constexpr utf16le<length> string = {ustring_view(String)};
 };
 
 /* storage allocation														*/
-template<ustring String>
+template<USBPLUSPLUS_STRING String>
 constexpr utf16le<cstring<String>::length> cstring<String>::string;
 
 /** List of strings															*/
-template<ustring ... List>
+template<USBPLUSPLUS_STRING ... List>
 struct list;
 
-template<ustring String>
+template<USBPLUSPLUS_STRING String>
 struct list<String> {
-	static constexpr unsigned indexof(ustring another) {
-		return equal(String, another) ? 1 : 0;
+	template<typename Another>
+	static constexpr unsigned indexof(const Another& another) {
+		return same_string(String, another) ? 1 : 0;
 	}
 };
 
 inline constexpr unsigned incifnz(unsigned v) { return v ? v + 1 : v; }
 
-template<ustring String, ustring ... List>
+template<USBPLUSPLUS_STRING String, USBPLUSPLUS_STRING ... List>
 struct list<String, List...> {
-	static constexpr unsigned indexof(ustring another) {
-		return equal(String, another)
+	template<typename Another>
+	static constexpr unsigned indexof(const Another& another) {
+		return same_string(String, another)
 			? 1 : incifnz(list<List...>::indexof(another));
 	}
 };
 }
-
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/bench/bench.hpp - minimal benchmarking helpers
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+namespace usbplusplus {
+namespace bench {
+
+// Prevents the compiler from optimizing value away
+template<typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs function iterations times and prints average time per iteration
+template<typename Function>
+double measure(const char* name, unsigned long iterations, Function&& function) {
+    using clock = std::chrono::steady_clock;
+    for (unsigned long i = 0; i < iterations / 16; ++i) {
+        function();
+    }
+    const auto start = clock::now();
+    for (unsigned long i = 0; i < iterations; ++i) {
+        function();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    const double result = elapsed.count() / static_cast<double>(iterations);
+    std::printf("%-48s %10.2f ns\n", name, result);
+    return result;
+}
+
+} // namespace bench
+} // namespace usbplusplus
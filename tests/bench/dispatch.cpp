@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/bench/dispatch.cpp - request dispatch latency, fold vs jump table
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/dispatch.hpp>
+#include "bench.hpp"
+
+using namespace usbplusplus;
+
+namespace {
+
+constexpr unsigned long iterations = 10'000'000;
+
+bool handle(StandardDeviceRequest request, unsigned& handled) {
+    handled += request.descriptor_type() == DescriptorType_t::STRING;
+    return true;
+}
+
+constexpr StandardDeviceRequest get_string{{
+    RequestType(DataTransferDirection_t::Device_to_Host, RequestType_t::Standard, Recipient_t::Device),
+    RequestCode_t::GET_DESCRIPTOR, static_cast<uint16_t>(static_cast<unsigned>(DescriptorType_t::STRING) << 8), 0, 64
+}};
+
+// Count vendor specific descriptor handlers, followed by the one that handles the request
+template<template<typename...> class Dispatcher, unsigned ... Index>
+auto make_dispatcher(std::integer_sequence<unsigned, Index...>) {
+    return Dispatcher<
+        dispatch::to<handle, dispatch::when<static_cast<DescriptorType_t>(0x40 + Index)>{}>...,
+        dispatch::to<handle, dispatch::when<DescriptorType_t::STRING>{}>
+    >{};
+}
+
+template<unsigned Count>
+void run() {
+    char name[64];
+    unsigned handled = 0;
+    auto fold = make_dispatcher<dispatch::dispatcher>(std::make_integer_sequence<unsigned, Count>{});
+    auto indexed = make_dispatcher<dispatch::indexed_dispatcher>(std::make_integer_sequence<unsigned, Count>{});
+    StandardDeviceRequest request = get_string;
+    std::snprintf(name, sizeof(name), "dispatcher, %u handlers", Count + 1);
+    bench::measure(name, iterations, [&] { bench::keep(request); fold(request, handled); });
+    std::snprintf(name, sizeof(name), "indexed_dispatcher, %u handlers", Count + 1);
+    bench::measure(name, iterations, [&] { bench::keep(request); indexed(request, handled); });
+    bench::keep(handled);
+}
+
+}
+
+int main() {
+    run<0>();
+    run<8>();
+    run<32>();
+    run<64>();
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/bench/feedback.cpp - feedback generator, driven by a drifting device clock
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/feedback.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include "bench.hpp"
+
+using namespace usbplusplus;
+
+namespace {
+
+constexpr unsigned seconds = 20;
+
+constexpr usb2::Endpoint Feedback(uint8_t interval, uint16_t size) {
+    return { {}, {}, EndpointAddress(1, EndpointDirection_t::IN),
+        usb2::Endpoint::Attributes(TransferType_t::Isochronous, usb2::SynchronizationType_t::No_Synchronization,
+            usb2::UsageType_t::Feedback_endpoint),
+        MaxPacketSize(size), Interval(interval) };
+}
+
+constexpr usb2::Endpoint full_speed_feedback = Feedback(1, 3);
+constexpr usb2::Endpoint high_speed_feedback = Feedback(1, 4);
+constexpr usb2::Endpoint high_speed_feedback_4 = Feedback(4, 4);
+
+// Host sends Ff samples per (micro)frame on average, the device consumes
+// samples at its own clock, off by ppm and drifting by wander ppm per
+// second. Reports (micro)frames until the measured rate stays within 10 ppm
+// of the device clock and the range of the buffer level, that starts at
+// target samples, or "not settled" if it does not stay within 10 ppm till the end
+template<const auto& Endpoint, BusSpeed_t Speed, unsigned Filter, unsigned Gain, unsigned Resolution>
+void simulate(const char* name, uint32_t rate, int ppm, int wander, bool report_level) {
+    using format = feedback::format<Speed>;
+    feedback::generator<Endpoint, Speed, Filter, Gain, Resolution> generator { format::of(rate) };
+    uint64_t device_rate = static_cast<uint64_t>(rate) * static_cast<uint64_t>(1000000 + ppm);
+    const uint64_t per_second = format::frames_per_second * uint64_t(1000000);
+    const int64_t target = 2 * rate / 1000;
+    uint64_t clock = 0;         // device samples * per_second
+    uint64_t host = 0;          // host accumulator in the fixed point format
+    int64_t level = target;
+    int64_t low = level;
+    int64_t high = level;
+    unsigned converged = 0;
+    const unsigned frames = seconds * format::frames_per_second;
+    for(unsigned frame = 0; frame < frames; ++frame) {
+        device_rate = static_cast<uint64_t>(static_cast<int64_t>(device_rate) +
+            int64_t(rate) * wander / int64_t(format::frames_per_second));
+        host += generator.value();
+        level += static_cast<int64_t>(host >> format::fraction_bits);
+        host &= (uint64_t(1) << format::fraction_bits) - 1;
+        const uint64_t consumed = (clock + device_rate) / per_second - clock / per_second;
+        clock += device_rate;
+        level -= static_cast<int64_t>(consumed);
+        low = level < low ? level : low;
+        high = level > high ? level : high;
+        if( report_level ) generator.occupancy(static_cast<int32_t>(level - target));
+        generator.sof(static_cast<uint32_t>((clock << Resolution) / per_second));
+        const uint64_t exact = (device_rate << format::fraction_bits) / per_second;
+        const uint64_t tolerance = exact / 100000;
+        const uint64_t value = generator.rate();
+        if( (value > exact ? value - exact : exact - value) > tolerance ) converged = frame + 1;
+    }
+    char settled[32];
+    if( converged == frames )
+        std::snprintf(settled, sizeof(settled), "not settled");
+    else
+        std::snprintf(settled, sizeof(settled), "%6u frames", converged);
+    std::printf("%-48s %12s, level %lld..%lld of %lld\n", name, settled,
+        static_cast<long long>(low), static_cast<long long>(high), static_cast<long long>(target));
+}
+
+}
+
+int main() {
+    using namespace feedback;
+    constexpr auto full = BusSpeed_t::Full;
+    constexpr auto high = BusSpeed_t::High;
+    simulate<full_speed_feedback, full, 8, 8, 0>("FS 44.1 kHz +100 ppm, sample counter", 44100, 100, 0, true);
+    simulate<full_speed_feedback, full, 8, 8, 8>("FS 44.1 kHz +100 ppm, 256 fs counter", 44100, 100, 0, true);
+    simulate<full_speed_feedback, full, 6, 8, 8>("FS 44.1 kHz +100 ppm, 256 fs, filter 6", 44100, 100, 0, true);
+    simulate<full_speed_feedback, full, 6, 8, 8>("FS 44.1 kHz +100 ppm, no level", 44100, 100, 0, false);
+    simulate<full_speed_feedback, full, 6, 8, 8>("FS 48 kHz -250 ppm, 10 ppm/s", 48000, -250, 10, true);
+    simulate<high_speed_feedback, high, 8, 8, 8>("HS 48 kHz +100 ppm, 256 fs", 48000, 100, 0, true);
+    simulate<high_speed_feedback_4, high, 6, 8, 8>("HS 48 kHz +100 ppm, bInterval 4", 48000, 100, 0, true);
+    simulate<high_speed_feedback, high, 8, 10, 8>("HS 192 kHz -500 ppm, 10 ppm/s", 192000, -500, 10, true);
+    return 0;
+}
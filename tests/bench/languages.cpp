@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/bench/languages.cpp - language lookup, linear indexof vs perfect hash
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/usbplusplus.hpp>
+#include "bench.hpp"
+#include <cstdio>
+
+using namespace usbplusplus;
+
+namespace {
+
+constexpr unsigned long iterations = 10'000'000;
+
+constexpr LanguageIdentifier language(std::size_t i) {
+    return static_cast<LanguageIdentifier>((i % 32 + 1) | (i / 32 + 1) << 10);
+}
+
+template<std::size_t ... I>
+void run(std::index_sequence<I...>) {
+    using languages = LanguageList<language(I)...>;
+    static constexpr LanguageIdentifier probes[] = { language(I)... };
+    char name[64];
+    unsigned pos = 0;
+    unsigned total = 0;
+    std::snprintf(name, sizeof(name), "LanguageList::indexof, %zu languages", sizeof...(I));
+    bench::measure(name, iterations, [&] {
+        bench::keep(pos);
+        total += languages::indexof(probes[pos]);
+        pos = pos + 1 < sizeof...(I) ? pos + 1 : 0;
+    });
+    std::snprintf(name, sizeof(name), "LanguageList::lookup, %zu languages", sizeof...(I));
+    bench::measure(name, iterations, [&] {
+        bench::keep(pos);
+        total += languages::lookup(probes[pos]);
+        pos = pos + 1 < sizeof...(I) ? pos + 1 : 0;
+    });
+    std::printf("%-48s %10zu bytes\n", "  perfect hash table", sizeof(languages::table));
+    bench::keep(total);
+}
+
+}
+
+int main() {
+    run(std::make_index_sequence<1>{});
+    run(std::make_index_sequence<8>{});
+    run(std::make_index_sequence<64>{});
+    return 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/bench/parse.cpp - configuration parsing, validation and scan for endpoints
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/parse.hpp>
+#include "configurations.hpp"
+#include "bench.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::usb2::tests;
+
+namespace {
+
+constexpr unsigned long iterations = 10'000'000;
+
+template<const auto& Config>
+void run(const char* name) {
+    static constexpr auto blob = parse::bytes_of(Config);
+    parse::bytes data { blob };
+    std::size_t total = 0;
+    bench::measure(name, iterations, [&] {
+        bench::keep(data);
+        total += parse::configuration{data}.count<usb2::Endpoint>();
+    });
+    bench::keep(total);
+}
+
+}
+
+int main() {
+    run<TestUAC2Configuration_1>("parse Configuration1, 2 endpoints");
+    run<TestUAC2Configuration_3>("parse Configuration3, 5 endpoints");
+    return 0;
+}
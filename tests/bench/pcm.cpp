@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/bench/pcm.cpp - throughput of PCM converters, native and scalar kernels
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/pcm.hpp>
+#include <usbplusplus/uac2.hpp>
+#include <cstdio>
+#include <vector>
+#include "bench.hpp"
+
+using namespace usbplusplus;
+
+namespace {
+
+constexpr unsigned long iterations = 20000;
+constexpr std::size_t frames = 1024;
+constexpr unsigned channels = 2;
+
+constexpr uac2::Type_I_Format_Type Format16 = { {}, {}, {}, {}, 2, 16 };
+constexpr uac2::Type_I_Format_Type Format24in3 = { {}, {}, {}, {}, 3, 24 };
+constexpr uac2::Type_I_Format_Type Format24in4 = { {}, {}, {}, {}, 4, 24 };
+constexpr uac2::Type_I_Format_Type Format32 = { {}, {}, {}, {}, 4, 32 };
+
+void report(double nanoseconds) {
+    std::printf("%-48s %10.1f Msamples/s\n", "",
+        static_cast<double>(frames * channels) * 1000.0 / nanoseconds);
+}
+
+template<typename Sample, const auto& Format, typename Kernels>
+void run(const char* format, const char* sample) {
+    using converter = pcm::converter<Format, channels, Kernels>;
+    std::vector<uint8_t> packet(frames * converter::frame_size, 0x5A);
+    std::vector<Sample> planes[channels];
+    Sample* pointers[channels];
+    for(unsigned c = 0; c < channels; ++c) {
+        planes[c].resize(frames);
+        pointers[c] = planes[c].data();
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s to %s, %s", format, sample, Kernels::isa);
+    report(bench::measure(name, iterations, [&] {
+        converter::to_planar(packet.data(), frames, pointers);
+        bench::keep(pointers[0][0]);
+    }));
+    std::snprintf(name, sizeof(name), "%s from %s, %s", format, sample, Kernels::isa);
+    report(bench::measure(name, iterations, [&] {
+        converter::from_planar(pointers, frames, packet.data());
+        bench::keep(packet[0]);
+    }));
+}
+
+template<const auto& Format>
+void run(const char* format) {
+    run<int32_t, Format, pcm::scalar>(format, "int32");
+    run<int32_t, Format, pcm::native>(format, "int32");
+    run<float, Format, pcm::scalar>(format, "float");
+    run<float, Format, pcm::native>(format, "float");
+}
+
+}
+
+int main() {
+    run<Format16>("16 bit stereo");
+    run<Format24in3>("24 bit in 3 stereo");
+    run<Format24in4>("24 bit in 4 stereo");
+    run<Format32>("32 bit stereo");
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/bench/scan.cpp - batch scanner of configuration dumps over a synthetic corpus
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "../ft/scan.hpp"
+#include <cstdio>
+#include <vector>
+#include "configurations.hpp"
+#include "bench.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::usb2::tests;
+
+namespace {
+
+constexpr unsigned dumps = 10'000;
+constexpr unsigned long iterations = 200;
+
+constexpr auto config1 = parse::bytes_of(TestUAC2Configuration_1);
+constexpr auto config3 = parse::bytes_of(TestUAC2Configuration_3);
+// wTotalLength past the end of the dump
+constexpr uint8_t truncated[] = { 0x09, 0x02, 0x12, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x09, 0x04 };
+// bLength of a descriptor past wTotalLength
+constexpr uint8_t overrun[] = { 0x09, 0x02, 0x0C, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x04, 0x24, 0x00 };
+
+// Corpus of dumps, one in every malformed_every is malformed
+struct corpus {
+    template<typename Dump>
+    void add(const Dump& dump) {
+        refs.push_back({ static_cast<uint32_t>(data.size()), static_cast<uint32_t>(std::size(dump)) });
+        data.insert(data.end(), std::begin(dump), std::end(dump));
+    }
+    std::vector<uint8_t> data {};
+    std::vector<ft::blob_ref> refs {};
+};
+
+corpus synthetic(unsigned malformed_every) {
+    corpus result;
+    for (unsigned i = 0; i < dumps; ++i) {
+        if (malformed_every && i % (2 * malformed_every) == 0)
+            result.add(overrun);
+        else if (malformed_every && i % malformed_every == 0)
+            result.add(truncated);
+        else if (i % 2)
+            result.add(config1);
+        else
+            result.add(config3);
+    }
+    return result;
+}
+
+void run(const char* name, unsigned malformed_every) {
+    const auto dumps_of = synthetic(malformed_every);
+    std::size_t total = 0;
+    const double ns = bench::measure(name, iterations, [&] {
+        bench::keep(dumps_of.data);
+        total += ft::scan(dumps_of.data, dumps_of.refs).positions.size();
+    });
+    bench::keep(total);
+    std::printf("%-48s %10.2f Mdumps/s\n", name, dumps * 1e3 / ns);
+}
+
+}
+
+int main() {
+    run("scan 10000 dumps, well formed", 0);
+    run("scan 10000 dumps, 1 in 16 malformed", 16);
+    return 0;
+}
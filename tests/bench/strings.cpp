@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/bench/strings.cpp - string descriptor fetch, per-string getters vs packed table
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "strings.hpp"
+#include "bench.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::usb1::tests;
+
+namespace {
+
+constexpr unsigned long iterations = 10'000'000;
+
+template<typename Dictionary>
+void run(const char* name) {
+    uint8_t index = 0;
+    unsigned total = 0;
+    bench::measure(name, iterations, [&] {
+        bench::keep(index);
+        total += Dictionary::get(index)[0];
+        index = static_cast<uint8_t>(index < Dictionary::count ? index + 1 : 0);
+    });
+    bench::keep(total);
+}
+
+}
+
+int main() {
+    run<TestStrings>("Strings::get");
+    run<TestPackedStrings>("PackedStrings::get");
+    return 0;
+}
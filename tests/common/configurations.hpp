@@ -175,5 +175,35 @@ constexpr const Configuration3 TestUAC2Configuration_3 = {
 
 } // namespace tests
 } // namespace usb2
+
+namespace usb3 {
+namespace tests {
+
+using StorageInterface = Interface<Array<Endpoint, 2>>;
+using StorageConfiguration = Configuration<Array<StorageInterface, 1>>;
+
+constexpr Endpoint TestBulkEndpoint(uint8_t addr, EndpointDirection_t dir) {
+    return {
+        Length<Endpoint>(),
+        {},
+        EndpointAddress(addr, dir),
+        Endpoint::Attributes(TransferType_t::Bulk),
+        MaxPacketSize(1024),
+        Interval(0),
+        bulk_companion<15, 4>()
+    };
+}
+
+constexpr const StorageConfiguration TestStorageConfiguration = {
+    {}, {}, {}, NumInterfaces(1), ConfigurationValue(1), Index(0), StorageConfiguration::Attributes(), MaxPower(100_mA),
+    {
+        { {}, {}, InterfaceNumber(0), AlternateSetting(0), {}, InterfaceClass::Mass_Storage, InterfaceSubClass(6),
+          InterfaceProtocol(0x50), Index(0), { TestBulkEndpoint(1, EndpointDirection_t::IN),
+                                               TestBulkEndpoint(2, EndpointDirection_t::OUT) } }
+    }
+};
+
+} // namespace tests
+} // namespace usb3
 } // namespace usbplusplus
 
@@ -72,4 +72,38 @@ constexpr const  Device_Qualifier TestDeviceQualifier_1_0 = {
 
 } // namespace tests
 } // namespace usb2
+
+namespace usb3 {
+namespace tests {
+
+using TestBOS = BOS<List<USB_2_0_Extension, SuperSpeed_USB>>;
+
+constexpr const TestBOS TestBOS_3_20 = {
+    .bLength = {},
+    .bDescriptorType = {},
+    .wTotalLength = {},
+    .bNumDeviceCaps = {},
+    .capabilities = {
+        {
+            .bLength = {},
+            .bDescriptorType = {},
+            .bDevCapabilityType = {},
+            .bmAttributes = USB_2_0_Extension::Attributes(Usb2ExtensionAttributes_t::LPM)
+        },
+        {
+            .bLength = {},
+            .bDescriptorType = {},
+            .bDevCapabilityType = {},
+            .bmAttributes = SuperSpeedAttributes_t::None,
+            .wSpeedsSupported = SpeedsSupported_t::Full_Speed | SpeedsSupported_t::High_Speed |
+                SpeedsSupported_t::Gen1_Speed,
+            .bFunctionalitySupport = FunctionalitySupport_t::Full_Speed,
+            .bU1DevExitLat = 0x0A,
+            .wU2DevExitLat = 0x07FF
+        }
+    }
+};
+
+} // namespace tests
+} // namespace usb3
 } // namespace usbplusplus
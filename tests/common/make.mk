@@ -7,7 +7,9 @@
 
 INCLUDES = include tests/common 
 BUILDDIR = build
-CFLAGS += -O2 $(INCLUDES:%=-I$(PROJROOT)%)
+# instruction set extension, e.g. ISA=avx2, to build with -mavx2 in a separate directory
+ISA =
+CFLAGS += -O2 $(INCLUDES:%=-I$(PROJROOT)%) $(ISA:%=-m%)
 CXXFLAGS += $(STD:%=-std=%) $(CFLAGS) $(WARNINGS) $(if $(findstring gcc, $(CXX)), $(GCCWARN))
 WARNINGS = -pedantic -Werror -Wall -Wextra -Wconversion -Wcast-align -Wcast-qual -Wctor-dtor-privacy -Wdisabled-optimization \
            -Wmissing-declarations -Wmissing-include-dirs  -Wold-style-cast -Woverloaded-virtual -Wredundant-decls \
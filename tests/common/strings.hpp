@@ -28,6 +28,39 @@ using TestStrings = Strings<LanguageIdentifier::English_United_States,
     sInterface,
     sSerialNumber>;
 
+using TestPackedStrings = PackedStrings<LanguageIdentifier::English_United_States,
+    sManufacturer,
+    sProduct,
+    sInterface,
+    sSerialNumber>;
+
+#if __cplusplus >= 202002L
+constexpr fixed_string fProduct = u"SuperPuper device";
+constexpr fixed_string fLongProduct =
+    u"SuperPuper device with a name, that does not fit in sixty three characters";
+
+constexpr auto fUkrainianProduct = u8"СуперПупер пристрій"_u16;
+constexpr auto fEmojiProduct = "Super😀device"_u16;
+
+using TestFixedStrings = Strings<LanguageIdentifier::English_United_States,
+    sManufacturer,
+    fProduct,
+    fLongProduct,
+    fUkrainianProduct,
+    fEmojiProduct>;
+#endif
+
+#if __cplusplus >= 201703L
+inline StringSlot<hex_length(4)> sSerialSlot;
+
+using TestSlotStrings = Strings<LanguageIdentifier::English_United_States,
+    sManufacturer,
+    &sSerialSlot>;
+
+using TestSlotMultiStrings = MultiStrings<
+    Strings<LanguageIdentifier::English_United_States, sManufacturer, &sSerialSlot>,
+    Strings<LanguageIdentifier::Ukrainian, uManufacturer, &sSerialSlot>>;
+#endif
 
 using TestMultiStrings = MultiStrings<
     Strings<LanguageIdentifier::English_United_States,
@@ -23,8 +23,234 @@ static_assert(TestUAC2Configuration_3.length() == 9, "TestUAC2Configuration_3.le
 static_assert(TestUAC2Configuration_3.totallength() == 71, "TestUAC2Configuration_3.totallength()");
 static_assert(TestUAC2Configuration_3.descriptortype() == DescriptorType_t::CONFIGURATION, "TestUAC2Configuration_3.descriptortype()");
 
+constexpr MaxPacketSize HighBandwidthPacket = maxpacketsize<TransferType_t::Isochronous, BusSpeed_t::High, 1024, 3>();
+static_assert(HighBandwidthPacket.get() == 0x1400, "HighBandwidthPacket.get()");
+static_assert(HighBandwidthPacket.size() == 1024, "HighBandwidthPacket.size()");
+static_assert(HighBandwidthPacket.transactions() == 3, "HighBandwidthPacket.transactions()");
+static_assert(HighBandwidthPacket.bytes() == 3072, "HighBandwidthPacket.bytes()");
+static_assert(maxpacketsize<TransferType_t::Interrupt, BusSpeed_t::High, 600, 2>().get() == 0x0A58,
+    "maxpacketsize<Interrupt, High, 600, 2>()");
+static_assert(maxpacketsize<TransferType_t::Bulk, BusSpeed_t::Full, 64>().transactions() == 1,
+    "maxpacketsize<Bulk, Full, 64>()");
+static_assert(MaxPacketSize(256).bytes() == 256, "MaxPacketSize(256).bytes()");
+
+#if __cplusplus >= 201703L
+using Index3 = ConfigurationIndex<TestUAC2Configuration_3>;
+static_assert(Index3::count == 3, "Index3::count");
+static_assert(Index3::interface_offset(1, 1) == 9, "Index3::interface_offset(1, 1)");
+static_assert(Index3::interface_offset(2, 1) == 25, "Index3::interface_offset(2, 1)");
+static_assert(Index3::interface_offset(3, 1) == 48, "Index3::interface_offset(3, 1)");
+static_assert(Index3::interface_offset(1, 0) == 0, "Index3::interface_offset(1, 0)");
+static_assert(Index3::interface_offset(4, 1) == 0, "Index3::interface_offset(4, 1)");
+static_assert(Index3::endpoint_offset(0x80) == 18, "Index3::endpoint_offset(0x80)");
+static_assert(Index3::endpoint_offset(0x02) == 41, "Index3::endpoint_offset(0x02)");
+static_assert(Index3::endpoint_offset(0x04) == 64, "Index3::endpoint_offset(0x04)");
+static_assert(Index3::endpoint_offset(0x84) == 0, "Index3::endpoint_offset(0x84)");
+
+using AlternateConfiguration = Configuration<List<Interface1, Interface2, Interface1>>;
+
+constexpr const AlternateConfiguration TestAlternateConfiguration = {
+    {}, {}, {}, NumInterfaces(1), ConfigurationValue(1), Index(0), AlternateConfiguration::Attributes(), MaxPower(100_mA),
+    {
+        { {}, {}, InterfaceNumber(0), AlternateSetting(0), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(3, EndpointDirection_t::IN, 64) } },
+        { {}, {}, InterfaceNumber(0), AlternateSetting(2), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(1, EndpointDirection_t::IN, 256),
+                                            TestEndpoint(1, EndpointDirection_t::OUT, 256) } },
+        { {}, {}, InterfaceNumber(0), AlternateSetting(1), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(2, EndpointDirection_t::IN, 256) } }
+    }
+};
+
+using AlternateIndex = ConfigurationIndex<TestAlternateConfiguration>;
+static_assert(AlternateIndex::interface_offset(0) == 9, "AlternateIndex::interface_offset(0)");
+static_assert(AlternateIndex::interface_offset(0, 2) == 25, "AlternateIndex::interface_offset(0, 2)");
+static_assert(AlternateIndex::interface_offset(0, 1) == 48, "AlternateIndex::interface_offset(0, 1)");
+static_assert(AlternateIndex::interface_offset(0, 3) == 0, "AlternateIndex::interface_offset(0, 3)");
+static_assert(AlternateIndex::endpoint_offset(0x83) == 18, "AlternateIndex::endpoint_offset(0x83)");
+static_assert(AlternateIndex::endpoint_offset(0x01) == 41, "AlternateIndex::endpoint_offset(0x01)");
+static_assert(AlternateIndex::endpoint_offset(0x82) == 57, "AlternateIndex::endpoint_offset(0x82)");
+
+static_assert(numinterfaces_of(TestAlternateConfiguration) == 1, "numinterfaces_of(TestAlternateConfiguration)");
+static_assert(numinterfaces_of(TestUAC2Configuration_3) == 3, "numinterfaces_of(TestUAC2Configuration_3)");
+static_assert(TestUAC2Configuration_3.numinterfaces() == 3, "TestUAC2Configuration_3.numinterfaces()");
+
+using AssociatedConfiguration = Configuration<List<InterfaceAssociation, Interface1, Interface1, Interface2>>;
+
+constexpr InterfaceAssociation TestAssociation = {
+    {}, {}, InterfaceNumber(7), Number<1>(2), FunctionClass::Audio, FunctionSubClass(0), FunctionProtocol(0), Index(0)
+};
+
+constexpr auto TestNumberedConfiguration = number_interfaces(AssociatedConfiguration {
+    {}, {}, {}, NumInterfaces(0), ConfigurationValue(1), Index(0), AssociatedConfiguration::Attributes(), MaxPower(100_mA),
+    {
+        TestAssociation,
+        { {}, {}, InterfaceNumber(5), AlternateSetting(0), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(1, EndpointDirection_t::IN, 64) } },
+        { {}, {}, InterfaceNumber(5), AlternateSetting(0), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(2, EndpointDirection_t::IN, 64) } },
+        { {}, {}, InterfaceNumber(5), AlternateSetting(1), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(2, EndpointDirection_t::IN, 256),
+                                            TestEndpoint(2, EndpointDirection_t::OUT, 256) } }
+    }
+});
+
+static_assert(TestNumberedConfiguration.bNumInterfaces.get() == 2, "TestNumberedConfiguration.bNumInterfaces");
+static_assert(TestNumberedConfiguration.interfaces.item0.bFirstInterface.get() == 0, "item0.bFirstInterface");
+static_assert(TestNumberedConfiguration.interfaces.item1.bInterfaceNumber.get() == 0, "item1.bInterfaceNumber");
+static_assert(TestNumberedConfiguration.interfaces.item2.bInterfaceNumber.get() == 1, "item2.bInterfaceNumber");
+static_assert(TestNumberedConfiguration.interfaces.item3.bInterfaceNumber.get() == 1, "item3.bInterfaceNumber");
+
+using OtherSpeedConfiguration = Other_Speed_Configuration<List<Interface1, Interface1>>;
+
+constexpr auto TestOtherSpeedConfiguration = count_interfaces(OtherSpeedConfiguration {
+    {}, {}, {}, NumInterfaces(0), ConfigurationValue(1), Index(0),
+    OtherSpeedConfiguration::Attributes(), MaxPower(100_mA),
+    {
+        { {}, {}, InterfaceNumber(0), AlternateSetting(0), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(1, EndpointDirection_t::IN, 64) } },
+        { {}, {}, InterfaceNumber(0), AlternateSetting(1), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(1, EndpointDirection_t::IN, 256) } }
+    }
+});
+
+static_assert(TestOtherSpeedConfiguration.numinterfaces() == 1, "TestOtherSpeedConfiguration.numinterfaces()");
+static_assert(TestOtherSpeedConfiguration.bNumInterfaces.get() == 1, "TestOtherSpeedConfiguration.bNumInterfaces");
+static_assert(numinterfaces_of(TestOtherSpeedConfiguration) == 1, "numinterfaces_of(TestOtherSpeedConfiguration)");
+static_assert(interfaces_counted(TestOtherSpeedConfiguration), "interfaces_counted(TestOtherSpeedConfiguration)");
+static_assert(interfaces_counted(TestAlternateConfiguration), "interfaces_counted(TestAlternateConfiguration)");
+static_assert(!interfaces_counted([] {
+    auto configuration = TestAlternateConfiguration;
+    configuration.bNumInterfaces = 3;
+    return configuration;
+}()), "!interfaces_counted(bNumInterfaces = 3)");
+
+#if __cplusplus >= 202002L
+using OtherSpeedConfiguration2 = Other_Speed_Configuration<List<Interface1, Interface2>>;
+
+constexpr OtherSpeedConfiguration2 TestOtherSpeedDefault = {
+    .bLength = {}, .bDescriptorType = {}, .wTotalLength = {},
+    .bConfigurationValue = ConfigurationValue(1), .iConfiguration = Index(0),
+    .bmAttributes = OtherSpeedConfiguration2::Attributes(), .bMaxPower = MaxPower(100_mA),
+    .interfaces = {
+        { {}, {}, InterfaceNumber(0), AlternateSetting(0), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(1, EndpointDirection_t::IN, 64) } },
+        { {}, {}, InterfaceNumber(1), AlternateSetting(0), {}, InterfaceClass::Audio, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(2, EndpointDirection_t::IN, 64),
+                                            TestEndpoint(2, EndpointDirection_t::OUT, 64) } }
+    }
+};
+
+static_assert(TestOtherSpeedDefault.bNumInterfaces.get() == 2, "TestOtherSpeedDefault.bNumInterfaces");
+static_assert(interfaces_counted(TestOtherSpeedDefault), "interfaces_counted(TestOtherSpeedDefault)");
+#endif
+
+using Memory2 = PacketMemory<TestUAC2Configuration_2, 2112, 64, true, 64>;
+static_assert(Memory2::count == 4, "Memory2::count");
+static_assert(Memory2::size == 64 + 4 * 2 * 256, "Memory2::size");
+static_assert(Memory2::find(0x81)->offset == 64, "Memory2::find(0x81)->offset");
+static_assert(Memory2::find(0x02)->offset == 576, "Memory2::find(0x02)->offset");
+static_assert(Memory2::find(0x04)->buffers == 2, "Memory2::find(0x04)->buffers");
+static_assert(Memory2::find(0x84) == nullptr, "Memory2::find(0x84)");
+static_assert(Memory2::table[3].address == 0x04, "Memory2::table[3].address");
+
+constexpr auto TestNumberedEndpoints = number_endpoints(TestUAC2Configuration_3);
+static_assert(TestNumberedEndpoints.interfaces.item0.endpoints.item0.bEndpointAddress.get() == 0x81, "item0 endpoint");
+static_assert(TestNumberedEndpoints.interfaces.item1.endpoints[0].bEndpointAddress.get() == 0x82, "item1 endpoint 0");
+static_assert(TestNumberedEndpoints.interfaces.item1.endpoints[1].bEndpointAddress.get() == 0x01, "item1 endpoint 1");
+static_assert(TestNumberedEndpoints.interfaces.item2.endpoints[0].bEndpointAddress.get() == 0x83, "item2 endpoint 0");
+static_assert(TestNumberedEndpoints.interfaces.item2.endpoints[1].bEndpointAddress.get() == 0x02, "item2 endpoint 1");
+
+using CrowdedInterface = Interface<Array<Endpoint, 16>>;
+using CrowdedConfiguration = Configuration<List<CrowdedInterface>>;
+
+/* sixteen IN endpoints, one more than there are numbers				*/
+constexpr CrowdedConfiguration crowded() {
+    constexpr Endpoint in = TestEndpoint(0, EndpointDirection_t::IN, 64);
+    return { {}, {}, {}, NumInterfaces(1), ConfigurationValue(1), Index(0), CrowdedConfiguration::Attributes(),
+             MaxPower(100_mA), { { {}, {}, InterfaceNumber(0), AlternateSetting(0), {}, InterfaceClass::Audio,
+             InterfaceSubClass(0), InterfaceProtocol(0), Index(0),
+             { in, in, in, in, in, in, in, in, in, in, in, in, in, in, in, in } } } };
+}
+
+constexpr bool numbered(CrowdedConfiguration configuration) {
+    return try_number_endpoints(configuration);
+}
+
+constexpr uint8_t last_number(CrowdedConfiguration configuration) {
+    try_number_endpoints(configuration);
+    return static_cast<uint8_t>(configuration.interfaces.item0.endpoints[15].bEndpointAddress.get() & 0x0F);
+}
+
+static_assert(!numbered(crowded()), "try_number_endpoints(crowded())");
+static_assert(last_number(crowded()) == 0, "crowded() endpoint 15");
+
+/* alternate settings share endpoints and their buffers					*/
+constexpr auto TestNumberedAlternates = number_endpoints(TestAlternateConfiguration);
+using AlternateMemory = PacketMemory<TestNumberedAlternates, 512>;
+static_assert(AlternateMemory::count == 2, "AlternateMemory::count");
+static_assert(AlternateMemory::find(0x81)->size == 256, "AlternateMemory::find(0x81)->size");
+static_assert(AlternateMemory::find(0x01)->offset == 256, "AlternateMemory::find(0x01)->offset");
+static_assert(AlternateMemory::size == 512, "AlternateMemory::size");
+
+using FullSpeed2 = PeriodicBandwidth<TestUAC2Configuration_2, BusSpeed_t::Full, true>;
+static_assert(FullSpeed2::setting(1, 1) == 2 * (256 + 9), "FullSpeed2::setting(1, 1)");
+static_assert(FullSpeed2::setting(1, 0) == 0, "FullSpeed2::setting(1, 0)");
+static_assert(FullSpeed2::worst == 4 * (256 + 9), "FullSpeed2::worst");
+static_assert(FullSpeed2::limit == 1350, "FullSpeed2::limit");
+
+using AlternateBandwidth = PeriodicBandwidth<TestAlternateConfiguration, BusSpeed_t::Full>;
+static_assert(AlternateBandwidth::worst == 2 * (256 + 9), "AlternateBandwidth::worst");
+
+/* two high-bandwidth endpoints, three 1024 byte transactions each		*/
+constexpr const Configuration1 TestHighBandwidthConfiguration = {
+    {}, {}, {}, NumInterfaces(2), ConfigurationValue(1), Index(0), Configuration1::Attributes(), MaxPower(100_mA),
+    {
+        { {}, {}, InterfaceNumber(0), AlternateSetting(0), {}, InterfaceClass::Video, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(1, EndpointDirection_t::IN, HighBandwidthPacket.get()) } },
+        { {}, {}, InterfaceNumber(1), AlternateSetting(0), {}, InterfaceClass::Video, InterfaceSubClass(0),
+          InterfaceProtocol(0), Index(0), { TestEndpoint(2, EndpointDirection_t::IN, HighBandwidthPacket.get()) } }
+    }
+};
+
+using HighBandwidth = PeriodicBandwidth<TestHighBandwidthConfiguration, BusSpeed_t::High>;
+static_assert(HighBandwidth::setting(0) == 3 * (1024 + 38), "HighBandwidth::setting(0)");
+static_assert(HighBandwidth::limit == 6000, "HighBandwidth::limit");
+static_assert(! HighBandwidth::fits, "HighBandwidth::fits");
+
+/* a buffer holds all transactions of a microframe						*/
+using HighBandwidthMemory = PacketMemory<TestHighBandwidthConfiguration, 6144>;
+static_assert(HighBandwidthMemory::find(0x81)->size == 3 * 1024, "HighBandwidthMemory::find(0x81)->size");
+static_assert(HighBandwidthMemory::find(0x82)->offset == 3 * 1024, "HighBandwidthMemory::find(0x82)->offset");
+static_assert(HighBandwidthMemory::size == 6144, "HighBandwidthMemory::size");
+#endif
+
 } // namespace tests
 } // namespace usb2
+
+namespace usb3 {
+namespace tests {
+
+static_assert(Endpoint::length() == 7, "Endpoint::length()");
+static_assert(Endpoint_Companion::length() == 6, "Endpoint_Companion::length()");
+static_assert(TestStorageConfiguration.totallength() == 44, "TestStorageConfiguration.totallength()");
+static_assert(TestStorageConfiguration.interfaces[0].bNumEndpoints.get() == 2, "bNumEndpoints");
+
+constexpr Endpoint_Companion IsochronousCompanion = periodic_companion<TransferType_t::Isochronous, 1024, 15, 2>();
+static_assert(IsochronousCompanion.bMaxBurst.get() == 15, "IsochronousCompanion.bMaxBurst");
+static_assert(IsochronousCompanion.bmAttributes.get() == 2, "IsochronousCompanion.bmAttributes");
+static_assert(IsochronousCompanion.wBytesPerInterval.get() == 49152, "IsochronousCompanion.wBytesPerInterval");
+static_assert(periodic_companion<TransferType_t::Interrupt, 64>().wBytesPerInterval.get() == 64,
+    "periodic_companion<Interrupt, 64>()");
+
+#if __cplusplus >= 201703L
+using StorageIndex = ConfigurationIndex<TestStorageConfiguration>;
+static_assert(StorageIndex::endpoint_offset(0x81) == 18, "StorageIndex::endpoint_offset(0x81)");
+static_assert(StorageIndex::endpoint_offset(0x02) == 31, "StorageIndex::endpoint_offset(0x02)");
+#endif
+
+} // namespace tests
+} // namespace usb3
 } // namespace usbplusplus
 
 
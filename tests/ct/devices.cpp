@@ -23,4 +23,17 @@ static_assert(TestDeviceQualifier_1_0.length() == 10, "TestDeviceQualifier_1_0.l
 
 } // namespace tests
 } // namespace usb2
+
+namespace usb3 {
+namespace tests {
+
+static_assert(TestBOS_3_20.length() == 5, "TestBOS_3_20.length()");
+static_assert(TestBOS_3_20.totallength() == 22, "TestBOS_3_20.totallength()");
+static_assert(TestBOS_3_20.descriptortype() == DescriptorType_t::BOS, "TestBOS_3_20.descriptortype()");
+static_assert(TestBOS_3_20.bNumDeviceCaps.get() == 2, "TestBOS_3_20.bNumDeviceCaps");
+static_assert(USB_2_0_Extension::length() == 7, "USB_2_0_Extension::length()");
+static_assert(SuperSpeed_USB::length() == 10, "SuperSpeed_USB::length()");
+
+} // namespace tests
+} // namespace usb3
 } // namespace usbplusplus
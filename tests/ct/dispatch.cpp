@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ct/dispatch.cpp - compile time tests for request dispatching
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#if __cplusplus >= 201703L
+#include <usbplusplus/dispatch.hpp>
+#include <usbplusplus/cdc.hpp>
+#include "configurations.hpp"
+
+namespace usbplusplus {
+namespace dispatch {
+namespace tests {
+
+using detail::code_of;
+using detail::descriptor_of;
+using detail::route_map;
+
+constexpr StandardDeviceRequest class_request(Recipient_t recipient, uint8_t code) {
+    return {{ RequestType(DataTransferDirection_t::Host_to_device, RequestType_t::Class, recipient),
+              static_cast<RequestCode>(code), 0, 0, 0 }};
+}
+
+static_assert(code_of<when<RequestCode::GET_STATUS>>::value == 0, "code_of<GET_STATUS>");
+static_assert(code_of<when<RequestCode::SET_FEATURE, Recipient_t::Endpoint>>::value == 3, "code_of<SET_FEATURE>");
+static_assert(code_of<when<DescriptorType_t::STRING>>::value == 6, "code_of<STRING>");
+static_assert(code_of<int>::value == -1, "code_of<int>");
+static_assert(descriptor_of<when<DescriptorType_t::STRING>>::value == 3, "descriptor_of<STRING>");
+static_assert(descriptor_of<when<RequestCode::GET_DESCRIPTOR>>::value == -1, "descriptor_of<GET_DESCRIPTOR>");
+static_assert(detail::max_of(-1) == -1, "max_of(-1)");
+static_assert(detail::max_of(-1, 3, 17, 2) == 17, "max_of(-1, 3, 17, 2)");
+static_assert(code_of<when<RequestType_t::Class, Recipient_t::Interface, cdc::CdcRequestCode_t::SET_LINE_CODING>>::value == -1,
+    "code_of<SET_LINE_CODING>");
+
+static_assert(when<RequestType_t::Class>{} == class_request(Recipient_t::Endpoint, 0x01), "when<Class>");
+static_assert(!(when<RequestType_t::Vendor>{} == class_request(Recipient_t::Endpoint, 0x01)), "when<Vendor>");
+static_assert(when<RequestType_t::Class, Recipient_t::Interface, cdc::CdcRequestCode_t::SET_LINE_CODING>{} ==
+    class_request(Recipient_t::Interface, 0x20), "when<Class, Interface, SET_LINE_CODING>");
+static_assert(!(when<RequestType_t::Class, Recipient_t::Interface, cdc::CdcRequestCode_t::SET_LINE_CODING>{} ==
+    class_request(Recipient_t::Endpoint, 0x20)), "when<Class, Interface, SET_LINE_CODING> for Endpoint");
+
+constexpr route_map map = route_map::of(usb2::tests::TestUAC2Configuration_3);
+static_assert(map.interfaces == 4, "map.interfaces");
+static_assert(!map.declared(0) && map.declared(1) && map.declared(2) && map.declared(3), "map.declared");
+static_assert(map.owners[route_map::slot(0x80)] == 1 + 1, "map.owners[0x80]");
+static_assert(map.owners[route_map::slot(0x81)] == 2 + 1, "map.owners[0x81]");
+static_assert(map.owners[route_map::slot(0x02)] == 2 + 1, "map.owners[0x02]");
+static_assert(map.owners[route_map::slot(0x04)] == 3 + 1, "map.owners[0x04]");
+static_assert(map.owners[route_map::slot(0x84)] == 0, "map.owners[0x84]");
+
+} // namespace tests
+} // namespace dispatch
+} // namespace usbplusplus
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ct/image.cpp - compile time tests for DeviceImage
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#if __cplusplus >= 201703L
+#include "configurations.hpp"
+#include "devices.hpp"
+
+namespace usbplusplus {
+namespace usb2 {
+namespace tests {
+
+using Image = DeviceImage<TestStrings, TestDevice_2_00, TestDeviceQualifier_1_0,
+                          TestUAC2Configuration_1, TestUAC2Configuration_2>;
+
+constexpr unsigned strings_size = 4 + (2 + 2 * 14) + (2 + 2 * 17) + (2 + 2 * 9) + (2 + 2 * 10);
+
+static_assert(Image::size == sizeof(TestDevice_2_00) + sizeof(TestDeviceQualifier_1_0) +
+    sizeof(TestUAC2Configuration_1) + sizeof(TestUAC2Configuration_2) + strings_size, "Image::size");
+static_assert(Image::count == 4 + 1 + TestStrings::count, "Image::count");
+
+using MultiImage = DeviceImage<TestMultiStrings, TestDevice_2_00>;
+
+/* sManufacturer and sInterface are stored once							*/
+constexpr unsigned multi_strings_size = (2 + 2 * 3) + (2 + 2 * 14) + (2 + 2 * 17) + (2 + 2 * 9) +
+    (2 + 2 * 17) + (2 + 2 * 15) + (2 + 2 * 19);
+
+static_assert(MultiImage::size == sizeof(TestDevice_2_00) + multi_strings_size, "MultiImage::size");
+static_assert(MultiImage::count == 1 + 1 + 3 * TestMultiStrings::count, "MultiImage::count");
+
+/* run time strings take no room in the image								*/
+using SlotImage = DeviceImage<TestSlotMultiStrings, TestDevice_2_00>;
+static_assert(SlotImage::size == sizeof(TestDevice_2_00) + (2 + 2 * 2) + (2 + 2 * 14) + (2 + 2 * 15),
+    "SlotImage::size");
+
+} // namespace tests
+} // namespace usb2
+} // namespace usbplusplus
+#endif
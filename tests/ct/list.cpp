@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ct/list.cpp - compile time tests and benchmark for List
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "configurations.hpp"
+#include <type_traits>
+
+namespace usbplusplus {
+namespace usb2 {
+namespace tests {
+
+using Endpoints9 = List<Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint,
+    Endpoint>;
+using Endpoints11 = List<Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint,
+    Endpoint, Endpoint, Endpoint>;
+
+static_assert(Endpoints9::count == 9, "Endpoints9::count");
+static_assert(Endpoints11::count == 11, "Endpoints11::count");
+static_assert(sizeof(Endpoints11::type) == 11 * sizeof(Endpoint), "sizeof(Endpoints11::type)");
+static_assert(sizeof(Configuration3::Interfaces) == sizeof(Interface1) + 2 * sizeof(Interface2),
+    "sizeof(Configuration3::Interfaces)");
+
+#if __cplusplus >= 201703L
+/* Benchmark: compile with -DLIST_ITEMS=N to measure a list of N items only */
+#ifndef LIST_ITEMS
+#define LIST_ITEMS 10, 50, 200
+#endif
+
+template<std::size_t I>
+using item_type = std::conditional_t<I % 2 == 0, Endpoint, detail::field<2>>;
+
+template<std::size_t I>
+constexpr item_type<I> item() {
+    if constexpr( I % 2 == 0 )
+        return TestEndpoint(1, EndpointDirection_t::IN, static_cast<uint16_t>(I));
+    else
+        return static_cast<uint16_t>(I);
+}
+
+constexpr uint16_t value_of(const Endpoint& endpoint) { return endpoint.wMaxPacketSize.get(); }
+constexpr uint16_t value_of(const detail::field<2>& field) { return field.get(); }
+
+template<typename Sequence>
+struct long_list;
+
+template<std::size_t ... I>
+struct long_list<std::index_sequence<I...>> {
+    using list = List<item_type<I>...>;
+    static constexpr typename list::type value = { item<I>() ... };
+    static constexpr bool valid() {
+        unsigned next = 0;
+        bool ordered = true;
+        value.each([&](const auto& item) { ordered = ordered && value_of(item) == next++; });
+        return ordered && list::count == sizeof...(I) && sizeof(value) == (sizeof(item_type<I>) + ...);
+    }
+};
+
+template<std::size_t ... N>
+constexpr bool valid_lists() {
+    return detail::all_of(long_list<std::make_index_sequence<N>>::valid() ...);
+}
+
+static_assert(valid_lists<LIST_ITEMS>(), "List<LIST_ITEMS>");
+static_assert(List<Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint, Endpoint,
+    Endpoint, Endpoint, Endpoint, Endpoint>::count == 12, "List<12 endpoints>::count");
+#endif
+
+} // namespace tests
+} // namespace usb2
+} // namespace usbplusplus
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ct/parse.cpp - compile time tests for the descriptor parser
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#if __cplusplus >= 202002L
+#include <usbplusplus/parse.hpp>
+#include <usbplusplus/cdc.hpp>
+#include <usbplusplus/uac2.hpp>
+#include "configurations.hpp"
+
+namespace usbplusplus {
+namespace parse {
+namespace tests {
+
+using usb2::tests::TestUAC2Configuration_3;
+
+constexpr auto config3 = bytes_of(TestUAC2Configuration_3);
+
+constexpr unsigned endpoints_in(bytes blob) {
+    unsigned result = 0;
+    configuration{blob}.each<usb2::Endpoint>([&](auto endpoint) {
+        result += (endpoint.value().bEndpointAddress.get() & 0x80) != 0;
+    });
+    return result;
+}
+
+static_assert(configuration{config3}.valid(), "configuration{config3}.valid()");
+static_assert(configuration{config3}.totallength() == sizeof(TestUAC2Configuration_3), "totallength()");
+static_assert(configuration{config3}.numinterfaces() == 3, "numinterfaces()");
+static_assert(configuration{config3}.count(DescriptorType_t::INTERFACE) == 3, "count(INTERFACE)");
+static_assert(configuration{config3}.count<usb2::Endpoint>() == 5, "count<Endpoint>()");
+static_assert(endpoints_in(config3) == 3, "endpoints_in(config3)");
+
+constexpr uint8_t truncated[] = { 0x09, 0x02, 0x12, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x09, 0x04 };
+constexpr uint8_t overrun[] = { 0x09, 0x02, 0x0C, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x04, 0x24, 0x00 };
+constexpr uint8_t zero_length[] = { 0x09, 0x02, 0x0C, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x00, 0x24, 0x00 };
+constexpr uint8_t short_total[] = { 0x09, 0x02, 0x05, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32 };
+constexpr uint8_t device[] = { 0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40, 0x02, 0x01, 0x04, 0x03 };
+
+static_assert(validate(truncated) == error_t::truncated, "validate(truncated)");
+static_assert(validate(overrun) == error_t::bad_length, "validate(overrun)");
+static_assert(validate(zero_length) == error_t::bad_length, "validate(zero_length)");
+static_assert(validate(short_total) == error_t::bad_total_length, "validate(short_total)");
+static_assert(validate(device) == error_t::not_configuration, "validate(device)");
+static_assert(configuration{overrun}.begin() == configuration{overrun}.end(), "invalid configuration is empty");
+static_assert(chain{overrun}.count(DescriptorType_t::CONFIGURATION) == 1, "chain stops at malformed descriptor");
+
+// CDC union and ECM functional descriptors of an interface
+constexpr uint8_t cdc_ecm[] = {
+    0x09, 0x04, 0x00, 0x00, 0x01, 0x02, 0x06, 0x00, 0x00,
+    0x05, 0x24, 0x06, 0x00, 0x01,
+    0x0D, 0x24, 0x0F, 0x05, 0x00, 0x00, 0x00, 0x00, 0xEA, 0x05, 0x00, 0x00, 0x00,
+};
+
+constexpr bool valid_union() {
+    for (auto item : chain{cdc_ecm}) {
+        if (item.is<cdc::CdcUnionFunctionalDescriptor<1>>()) {
+            const auto value = item.as<cdc::CdcUnionFunctionalDescriptor<1>>().value();
+            return value.bControlInterface.get() == 0 && value.bSubordinateInterface[0].get() == 1 &&
+                   item.context().interface_class == 0x02 && item.context().interface_subclass == 0x06;
+        }
+    }
+    return false;
+}
+
+static_assert(chain{cdc_ecm}.count<cdc::CdcUnionFunctionalDescriptor<1>>() == 1, "count<CdcUnionFunctionalDescriptor<1>>");
+static_assert(chain{cdc_ecm}.count<cdc::CdcUnionFunctionalDescriptor<2>>() == 0, "count<CdcUnionFunctionalDescriptor<2>>");
+static_assert(valid_union(), "valid_union()");
+
+// UAC2 AC interface with its header, AS interface with its header, both headers have subtype 1
+constexpr uint8_t uac2_headers[] = {
+    0x09, 0x04, 0x00, 0x00, 0x00, 0x01, 0x01, 0x20, 0x00,
+    0x09, 0x24, 0x01, 0x00, 0x02, 0x01, 0x09, 0x00, 0x00,
+    0x09, 0x04, 0x01, 0x01, 0x01, 0x01, 0x02, 0x20, 0x00,
+    0x10, 0x24, 0x01, 0x05, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x00,
+};
+
+using ControlHeader = uac2::AudioControl<List<uac2::Clock_Source>, uac2::None>::Header;
+using StreamingHeader = uac2::AudioStreaming<List<uac2::Type_I_Format_Type>,
+                                             List<uac2::AS_Isochronous_Audio_Data_Endpoint>>::Header;
+
+static_assert(chain{uac2_headers}.count<ControlHeader>() == 1, "count<AudioControl::Header>");
+static_assert(chain{uac2_headers}.count<StreamingHeader>() == 1, "count<AudioStreaming::Header>");
+static_assert(chain{bytes{uac2_headers}.subspan(18)}.count<ControlHeader>() == 0, "AS header is not AC header");
+static_assert(chain{bytes{uac2_headers}.subspan(27)}.count<ControlHeader>() == 1, "no context before any interface");
+
+} // namespace tests
+} // namespace parse
+} // namespace usbplusplus
+#endif
@@ -20,6 +20,64 @@ static_assert(TestStrings::indexof(sInterface) == 3, "TestStrings::indexof(sInte
 static_assert(TestStrings::indexof(sSerialNumber) == 4, "TestStrings::indexof(sSerialNumber)");
 static_assert(TestStrings::indexof(uProduct) == 0, "TestStrings::indexof(uProduct)");
 
+static_assert(TestPackedStrings::indexof(sSerialNumber) == 4, "TestPackedStrings::indexof(sSerialNumber)");
+
+constexpr detail::string_table<LanguageIdentifier::English_United_States, sInterface, sSerialNumber> table {};
+static_assert(sizeof(table.data) == 4 + 2 + 2 * 9 + 2 + 2 * 10, "sizeof(table.data)");
+static_assert(table.offsets[0] == 0 && table.offsets[1] == 4 && table.offsets[2] == 24, "table.offsets");
+static_assert(table.data[0] == 4 && table.data[2] == 0x09 && table.data[3] == 0x04, "table.data, Language List");
+static_assert(table.data[4] == 20 && table.data[5] == 3 && table.data[6] == 'I' && table.data[7] == 0, "table.data, sInterface");
+static_assert(table.data[24] == 22 && table.data[26] == 'S' && table.data[45] == 0, "table.data, sSerialNumber");
+
+static_assert(TestMultiStrings::bytes_saved == (2 + 2 * 14) + 2 * (2 + 2 * 9), "TestMultiStrings::bytes_saved");
+
+using TestLanguages = LanguageList<
+    LanguageIdentifier::English_United_States,
+    LanguageIdentifier::English_United_Kingdom,
+    LanguageIdentifier::Ukrainian,
+    LanguageIdentifier::German_Standard>;
+static_assert(TestLanguages::lookup(LanguageIdentifier::English_United_States) == 1, "TestLanguages::lookup(English_United_States)");
+static_assert(TestLanguages::lookup(LanguageIdentifier::Ukrainian) == 3, "TestLanguages::lookup(Ukrainian)");
+static_assert(TestLanguages::lookup(LanguageIdentifier::German_Standard) == 4, "TestLanguages::lookup(German_Standard)");
+static_assert(TestLanguages::lookup(LanguageIdentifier::English_Canadian) == 0, "TestLanguages::lookup(English_Canadian)");
+static_assert(LanguageList<>::lookup(LanguageIdentifier::Ukrainian) == 0, "LanguageList<>::lookup(Ukrainian)");
+
+template<typename Sequence>
+struct many_languages;
+
+template<std::size_t ... I>
+struct many_languages<std::index_sequence<I...>> {
+    using type = LanguageList<static_cast<LanguageIdentifier>((I % 32 + 1) | (I / 32 + 1) << 10) ...>;
+    static constexpr bool all_found() {
+        return detail::all_of(type::lookup(static_cast<LanguageIdentifier>((I % 32 + 1) | (I / 32 + 1) << 10)) == I + 1 ...);
+    }
+};
+static_assert(many_languages<std::make_index_sequence<64>>::all_found(), "LanguageList<64 languages>::lookup");
+
+#if __cplusplus >= 202002L
+static_assert(sizeof(fProduct) == sizeof(u"SuperPuper device"), "sizeof(fProduct)");
+static_assert(fLongProduct.size() >= ustring_size, "fLongProduct.size()");
+static_assert(TestFixedStrings::indexof(fProduct) == 2, "TestFixedStrings::indexof(fProduct)");
+static_assert(TestFixedStrings::indexof(sProduct) == 2, "TestFixedStrings::indexof(sProduct)");
+static_assert(TestFixedStrings::indexof(fLongProduct) == 3, "TestFixedStrings::indexof(fLongProduct)");
+static_assert(String<fLongProduct>::length() == 2 + 2 * fLongProduct.size(), "String<fLongProduct>::length()");
+static_assert(cstring<fProduct>::length == length(sProduct), "cstring<fProduct>::length");
+static_assert(equal(fUkrainianProduct, uProduct), "fUkrainianProduct");
+static_assert(equal(u8"Ї"_u16, u"Ї") && equal("ї"_u16, u"ї") && equal(""_u16, u""), "_u16");
+static_assert(fEmojiProduct.size() == 13, "fEmojiProduct.size()");
+static_assert(fEmojiProduct.value[5] == 0xD83D && fEmojiProduct.value[6] == 0xDE00, "fEmojiProduct surrogates");
+static_assert(equal(u8"\U0010FFFF"_u16, u"\U0010FFFF"), "U+10FFFF");
+#endif
+
+static_assert(hex_length(12) == 24, "hex_length(12)");
+static_assert(base32_length(6) == 10 && base32_length(5) == 8, "base32_length");
+#if __cplusplus >= 201703L
+static_assert(TestSlotStrings::indexof(&sSerialSlot) == 2, "TestSlotStrings::indexof(&sSerialSlot)");
+static_assert(TestSlotStrings::indexof(sManufacturer) == 1, "TestSlotStrings::indexof(sManufacturer)");
+static_assert(TestSlotMultiStrings::indexof(&sSerialSlot) == 2, "TestSlotMultiStrings::indexof(&sSerialSlot)");
+static_assert(TestSlotMultiStrings::bytes_saved == 0, "TestSlotMultiStrings::bytes_saved");
+#endif
+
 static_assert(TestMultiStrings::indexof(sManufacturer) == 1, "TestMultiStrings::indexof(sManufacturer)");
 static_assert(TestMultiStrings::indexof(sProduct) == 2, "TestMultiStrings::indexof(sProduct)");
 static_assert(TestMultiStrings::indexof(sInterface) == 3, "TestMultiStrings::indexof(sInterface)");
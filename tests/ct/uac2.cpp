@@ -29,6 +29,51 @@ static_assert(AudioControlInterface::length() == 9, "AudioControlInterface::leng
 static_assert(AudioControlInterface::Header::totallength() == 60, "AudioControlInterface::Header::totallength()");
 static_assert(SpeakerStreamingInterface::length() == 9, "SpeakerStreamingInterface::length()");
 
+#if __cplusplus >= 201703L
+constexpr Type_I_Format_Type Format24in3 = { {}, {}, {}, {}, 3, 24 };
+
+constexpr AS_Isochronous_Audio_Data_Endpoint FullSpeedEndpoint = {
+    { {}, {}, EndpointAddress(1, EndpointDirection_t::OUT), Endpoint::Attributes(TransferType_t::Isochronous),
+      MaxPacketSize(270), Interval(1) },
+    {}, {}, {}, AS_Isochronous_Audio_Data_Endpoint::Attributes(false), {}, LockDelayUnits_t::Undefined, 0
+};
+
+constexpr Endpoint HighSpeedEndpoint = {
+    {}, {}, EndpointAddress(1, EndpointDirection_t::IN), Endpoint::Attributes(TransferType_t::Isochronous),
+    MaxPacketSize(512), Interval(4)
+};
+
+using Schedule44k1 = PacketSchedule<Format24in3, FullSpeedEndpoint, 2, 44100, BusSpeed_t::Full>;
+static_assert(Schedule44k1::frame_size == 6, "Schedule44k1::frame_size");
+static_assert(Schedule44k1::period == 10, "Schedule44k1::period");
+static_assert(Schedule44k1::min_frames == 44, "Schedule44k1::min_frames");
+static_assert(Schedule44k1::max_bytes == 270, "Schedule44k1::max_bytes");
+static_assert(Schedule44k1::frames(8) == 44 && Schedule44k1::frames(9) == 45, "Schedule44k1::frames");
+
+template<typename Schedule>
+constexpr unsigned frames_in_period() {
+    Schedule schedule {};
+    unsigned frames = 0;
+    for(unsigned n = 0; n < Schedule::period; ++n) {
+        const unsigned next = schedule.next();
+        if( next != Schedule::frames(n) ) return 0;
+        frames += next;
+    }
+    return frames;
+}
+static_assert(frames_in_period<Schedule44k1>() == 441, "frames_in_period<Schedule44k1>");
+
+using Schedule88k2 = PacketSchedule<Format24in3, HighSpeedEndpoint, 1, 88200, BusSpeed_t::High>;
+static_assert(Schedule88k2::interval == 8, "Schedule88k2::interval");
+static_assert(Schedule88k2::interval_us == 1000, "Schedule88k2::interval_us");
+static_assert(Schedule88k2::period == 5, "Schedule88k2::period");
+static_assert(Schedule88k2::max_frames == 89, "Schedule88k2::max_frames");
+static_assert(frames_in_period<Schedule88k2>() == 441, "frames_in_period<Schedule88k2>");
+
+using Schedule48k = PacketSchedule<Format24in3, HighSpeedEndpoint, 1, 48000, BusSpeed_t::High>;
+static_assert(Schedule48k::period == 1 && Schedule48k::max_frames == 48, "Schedule48k");
+#endif
+
 } // namespace tests
 } // namespace usb1
 } // namespace usbplusplus
@@ -0,0 +1,295 @@
+/* Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ft/ftbench.cxx - bulk loopback throughput benchmark for the ft back-end
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wzero-length-array"
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+
+#include <libusb.h>
+#pragma GCC diagnostic pop
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers" // some field initializers are skipped by intent
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "usbsys.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::usb2;
+using namespace usbplusplus::ft;
+
+static constexpr int timeout = 5000; // milliseconds
+static constexpr uint16_t vendor_id = 0x0102;
+static constexpr uint16_t product_id = 0x0B0B;
+static constexpr uint8_t bulk_out = 0x01;
+static constexpr uint8_t bulk_in = 0x81;
+static constexpr uint8_t limited_out = 0x02;
+static constexpr std::size_t limited_rate = 8'000'000; // bytes per second
+
+constexpr ustring sProduct = u"Bulk loopback";
+using BenchStrings = Strings<LanguageIdentifier::English_United_States, sProduct>;
+
+constexpr const Device deviceDescriptor = {
+    .bLength = {},
+    .bDescriptorType = {},
+    .bcdUsb = 2.00_bcd,
+    .bDeviceClass = DeviceClass::Defined_in_the_Interface_Descriptors,
+    .bDeviceSubClass = 0,
+    .bDeviceProtocol = DeviceProtocol(0),
+    .bMaxPacketSize0 = MaxPacketSize0_t::_64,
+    .idVendor = vendor_id,
+    .idProduct = IDProduct(product_id),
+    .bcdDevice = 1.00_bcd,
+    .iManufacturer = Manufacturer(0),
+    .iProduct = Product(BenchStrings::indexof(sProduct)),
+    .iSerialNumber = SerialNumber(0),
+    .bNumConfigurations = NumConfigurations(1)
+};
+
+using LoopbackInterface = Interface<Array<Endpoint,3>>;
+using LoopbackConfiguration = Configuration<List<LoopbackInterface>>;
+
+constexpr const LoopbackConfiguration configuration = {
+    {},
+    {},
+    {},
+    NumInterfaces(1),
+    ConfigurationValue(1),
+    Index(0),
+    LoopbackConfiguration::Attributes(),
+    MaxPower(100_mA),
+    {
+        LoopbackInterface {
+            .bInterfaceNumber = 0,
+            .bAlternateSetting = 0,
+            .bInterfaceClass = InterfaceClass::Vendor_Specific,
+            .bInterfaceSubClass = 0,
+            .bInterfaceProtocol = 0,
+            .endpoints =
+                {
+                    {
+                        .bEndpointAddress = EndpointAddress(1, EndpointDirection_t::OUT),
+                        .bmAttributes = Endpoint::Attributes(TransferType_t::Bulk),
+                        .wMaxPacketSize = 512,
+                        .bInterval = 0,
+                    },
+                    {
+                        .bEndpointAddress = EndpointAddress(1, EndpointDirection_t::IN),
+                        .bmAttributes = Endpoint::Attributes(TransferType_t::Bulk),
+                        .wMaxPacketSize = 512,
+                        .bInterval = 0,
+                    },
+                    {
+                        .bEndpointAddress = EndpointAddress(2, EndpointDirection_t::OUT),
+                        .bmAttributes = Endpoint::Attributes(TransferType_t::Bulk),
+                        .wMaxPacketSize = 512,
+                        .bInterval = 0,
+                    },
+                },
+        },
+    }
+};
+
+static usbdevice loopback_device { devaddr::local, deviceDescriptor, BenchStrings{}, configuration };
+static loopback_endpoint loopback {};
+static sink_endpoint sink {};
+static rate_limited_endpoint limited { sink, limited_rate };
+
+struct bench_result {
+    std::size_t bytes;
+    std::size_t transfers;
+    std::chrono::duration<double> elapsed;
+};
+
+static bool bulk(libusb_device_handle* handle, uint8_t endpoint, std::vector<uint8_t>& data) {
+    int transferred = 0;
+    const int r = libusb_bulk_transfer(handle, endpoint, data.data(), static_cast<int>(data.size()),
+                                       &transferred, timeout);
+    if (r < 0 || static_cast<std::size_t>(transferred) != data.size()) {
+        fprintf(stderr, "Bulk transfer on 0x%02x failed: %s, %d of %zu bytes\n", endpoint, libusb_error_name(r),
+                transferred, data.size());
+        return false;
+    }
+    return true;
+}
+
+static int async_completed = 0;
+static libusb_transfer_status async_status = LIBUSB_TRANSFER_ERROR;
+
+static void LIBUSB_CALL async_callback(libusb_transfer* transfer) {
+    async_status = transfer->status;
+    async_completed = 1;
+}
+
+// Sends a packet to bulk OUT with an asynchronous transfer without user_data,
+// which the back-end must leave alone, and reads it back from bulk IN
+static bool async_bulk(libusb_device_handle* handle) {
+    std::vector<uint8_t> out(512, 0x5A);
+    std::vector<uint8_t> in(out.size());
+    libusb_transfer* transfer = libusb_alloc_transfer(0);
+    if (transfer == nullptr)
+        return false;
+    libusb_fill_bulk_transfer(transfer, handle, bulk_out, out.data(), static_cast<int>(out.size()), async_callback,
+                              nullptr, timeout);
+    async_completed = 0;
+    int r = libusb_submit_transfer(transfer);
+    while (r == 0 && !async_completed)
+        r = libusb_handle_events_completed(nullptr, &async_completed);
+    const bool done = r == 0 && async_status == LIBUSB_TRANSFER_COMPLETED &&
+                      static_cast<std::size_t>(transfer->actual_length) == out.size();
+    libusb_free_transfer(transfer);
+    if (!done) {
+        fprintf(stderr, "Asynchronous bulk transfer without user_data failed: %s\n", libusb_error_name(r));
+        return false;
+    }
+    return bulk(handle, bulk_in, in) && in == out;
+}
+
+// Posts an asynchronous read before the write, the read must wait for the data, as the device NAKs it,
+// rather than complete with an empty packet
+static bool read_before_write(libusb_device_handle* handle) {
+    std::vector<uint8_t> out(512);
+    std::vector<uint8_t> in(out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+        out[i] = static_cast<uint8_t>(i);
+    libusb_transfer* transfer = libusb_alloc_transfer(0);
+    if (transfer == nullptr)
+        return false;
+    libusb_fill_bulk_transfer(transfer, handle, bulk_in, in.data(), static_cast<int>(in.size()), async_callback,
+                              nullptr, timeout);
+    async_completed = 0;
+    int r = libusb_submit_transfer(transfer);
+    const bool early = async_completed != 0;
+    const bool written = r == 0 && bulk(handle, bulk_out, out);
+    while (r == 0 && !async_completed)
+        r = libusb_handle_events_completed(nullptr, &async_completed);
+    const bool done = r == 0 && !early && written && async_status == LIBUSB_TRANSFER_COMPLETED &&
+                      static_cast<std::size_t>(transfer->actual_length) == out.size() && in == out;
+    libusb_free_transfer(transfer);
+    printf("bulk read before write %s\n", done ? "PASS" : "FAIL");
+    return done;
+}
+
+// Selects the declared alternate setting and an undeclared one, which must be rejected
+static bool alternate_settings(libusb_device_handle* handle) {
+    const int declared = libusb_set_interface_alt_setting(handle, 0, 0);
+    const int undeclared = libusb_set_interface_alt_setting(handle, 0, 1);
+    const bool pass = declared == LIBUSB_SUCCESS && undeclared == LIBUSB_ERROR_NOT_FOUND;
+    printf("alternate setting 0 %s, undeclared 1 %s %s\n", libusb_error_name(declared), libusb_error_name(undeclared),
+           pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+struct async_counters {
+    int completed;
+    int failed;
+};
+
+static void LIBUSB_CALL count_callback(libusb_transfer* transfer) {
+    auto& counters = *static_cast<async_counters*>(transfer->user_data);
+    ++counters.completed;
+    if (transfer->status != LIBUSB_TRANSFER_COMPLETED || transfer->actual_length != transfer->length)
+        ++counters.failed;
+}
+
+// Submits overlapping transfers to the rate limited endpoint, which together must not exceed its rate,
+// and meanwhile makes a round trip through the loopback, which must not wait for them
+static bool rate_limit(libusb_device_handle* handle) {
+    constexpr std::size_t transfers = 8;
+    constexpr std::size_t size = 65536;
+    std::vector<uint8_t> data(transfers * size, 0xA5);
+    std::vector<uint8_t> out(512, 0x3C);
+    std::vector<uint8_t> in(out.size());
+    libusb_transfer* pending[transfers] {};
+    async_counters counters {};
+    const auto start = std::chrono::steady_clock::now();
+    int r = 0;
+    for (std::size_t i = 0; i < transfers && r == 0; ++i) {
+        pending[i] = libusb_alloc_transfer(0);
+        if (pending[i] == nullptr)
+            return false;
+        libusb_fill_bulk_transfer(pending[i], handle, limited_out, data.data() + i * size, static_cast<int>(size),
+                                  count_callback, &counters, timeout);
+        r = libusb_submit_transfer(pending[i]);
+        if (r != 0)
+            counters.completed += static_cast<int>(transfers - i);
+    }
+    const auto loopback_start = std::chrono::steady_clock::now();
+    const bool loopback_done = bulk(handle, bulk_out, out) && bulk(handle, bulk_in, in) && in == out;
+    const std::chrono::duration<double> loopback_time = std::chrono::steady_clock::now() - loopback_start;
+    while (counters.completed < static_cast<int>(transfers) && libusb_handle_events(nullptr) == 0) {}
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    for (auto transfer : pending)
+        libusb_free_transfer(transfer);
+    const double rate = static_cast<double>(transfers * size) / elapsed.count() / 1e6;
+    const double limit = static_cast<double>(limited_rate) / 1e6;
+    const bool pass = r == 0 && counters.failed == 0 && sink.received() == transfers * size && rate <= limit &&
+                      loopback_done && loopback_time < elapsed / 4;
+    printf("rate limited bulk transfers %.1f MB/s, limit %.1f MB/s, loopback meanwhile %.3f ms %s\n", rate, limit,
+           loopback_time.count() * 1e3, pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// Sends size bytes to bulk OUT and reads them back from bulk IN, count times
+static bool run(libusb_device_handle* handle, std::size_t size, std::size_t count, bench_result& result) {
+    std::vector<uint8_t> out(size);
+    std::vector<uint8_t> in(size);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t j = 0; j < size; ++j)
+            out[j] = static_cast<uint8_t>(i + j);
+        if (!bulk(handle, bulk_out, out) || !bulk(handle, bulk_in, in))
+            return false;
+        if (in != out) {
+            fprintf(stderr, "Loopback data mismatch at transfer %zu of %zu bytes\n", i, size);
+            return false;
+        }
+    }
+    result = { 2 * size * count, 2 * count, std::chrono::steady_clock::now() - start };
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    loopback_device.attach(bulk_out, loopback);
+    loopback_device.attach(bulk_in, loopback);
+    loopback_device.attach(limited_out, limited);
+
+    if (libusb_init_context(nullptr, nullptr, 0) < 0)
+        return 1;
+    libusb_device_handle* handle = libusb_open_device_with_vid_pid(nullptr, vendor_id, product_id);
+    if (handle == nullptr || libusb_claim_interface(handle, 0) < 0) {
+        fprintf(stderr, "Failed to open loopback device %04x:%04x\n", vendor_id, product_id);
+        if (handle != nullptr)
+            libusb_close(handle);
+        libusb_exit(nullptr);
+        return 1;
+    }
+    int retcode = async_bulk(handle) ? 0 : 1;
+    printf("async bulk transfer, null user_data %s\n", retcode == 0 ? "PASS" : "FAIL");
+    if (!read_before_write(handle) || !alternate_settings(handle) || !rate_limit(handle))
+        retcode = 1;
+    printf("%8s %10s %12s %14s\n", "size", "transfers", "MB/s", "transfers/s");
+    for (std::size_t size : { 512u, 4096u, 65536u }) {
+        bench_result result {};
+        if (!run(handle, size, count, result)) {
+            retcode = 1;
+            break;
+        }
+        const double seconds = result.elapsed.count();
+        printf("%8zu %10zu %12.1f %14.0f\n", size, result.transfers,
+               static_cast<double>(result.bytes) / seconds / 1e6, static_cast<double>(result.transfers) / seconds);
+    }
+    libusb_release_interface(handle, 0);
+    libusb_close(handle);
+    libusb_exit(nullptr);
+    return retcode;
+}
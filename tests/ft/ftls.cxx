@@ -16,6 +16,7 @@
 
 #include <utf8.hpp>
 #include "params.hpp"
+#include "scan.hpp"
 
 static constexpr int timeout = 5000; // 5ms
 
@@ -213,10 +214,59 @@ static int dump_descriptor(libusb_device **devs, const params& args) {
     return 2;
 }
 
+static bool read_file(const char* name, std::vector<uint8_t>& data) {
+    FILE* file = fopen(name, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "Error %d opening %s: %s\n", errno, name, strerror(errno));
+        return false;
+    }
+    uint8_t buf[4096];
+    std::size_t size;
+    while ((size = fread(buf, 1, sizeof(buf), file)) > 0)
+        data.insert(data.end(), buf, buf + size);
+    fclose(file);
+    return true;
+}
+
+static const char* error_name(usbplusplus::parse::error_t error) {
+    using usbplusplus::parse::error_t;
+    switch (error) {
+    case error_t::none: return "valid";
+    case error_t::truncated: return "truncated";
+    case error_t::not_configuration: return "not a configuration";
+    case error_t::bad_total_length: return "bad wTotalLength";
+    case error_t::bad_length: return "bad bLength";
+    default: return "unknown";
+    }
+}
+
+// Scans configuration dumps, one per file, as produced by --dump --format=B
+static int scan_dumps(const params& args) {
+    using namespace usbplusplus::ft;
+    std::vector<uint8_t> corpus;
+    std::vector<blob_ref> refs;
+    for (auto name : args.files) {
+        const auto offset = corpus.size();
+        if (!read_file(name, corpus))
+            return 1;
+        refs.push_back({static_cast<uint32_t>(offset), static_cast<uint32_t>(corpus.size() - offset)});
+    }
+    const auto index = scan(corpus, refs);
+    int retcode = 0;
+    for (std::size_t i = 0; i < refs.size(); ++i) {
+        const auto& blob = index.blobs[i];
+        printf("%s: %s, %u descriptors, %u interfaces, %u endpoints\n", args.files[i], error_name(blob.error),
+               blob.count, blob.interfaces, blob.endpoints);
+        retcode |= blob.error != usbplusplus::parse::error_t::none;
+    }
+    return retcode;
+}
+
 static void print_help() {
     printf("Usage:\n"
 "  ftls [--list] [--lang=<lang>]  [<bus>[:<addr>]]...\n\t\tLists devices matching by bus and addr\n"
 "  ftls --dump [--lang=<lang>] [--format=<fmt>] <bus>:<addr>:<descr>[:<index>]\n\t\tDumps descriptor\n"
+"  ftls --scan <file>...\n\t\tValidates configuration descriptor dumps, one per file\n"
 "  ftls --help\n\t\tPrints this help string\n"
 "Where:\n"
 "  <bus>   - bus number, 1..255\n"
@@ -237,6 +287,9 @@ int main(int argc, char *argv[]) {
         print_help();
         return 0;
     }
+    if (args.action == action_type::scan) {
+        return scan_dumps(args);
+    }
     libusb_device **devs;
     int r;
     ssize_t cnt;
@@ -50,11 +50,13 @@ enum class action_type {
     invalid,
     list,
     dump,
+    scan,
     help,
 };
 
 struct params {
     std::vector<device_info> filter;
+    std::vector<const char*> files;
     format_spec format;
     action_type action;
     libusb_descriptor_type type;
@@ -121,6 +123,12 @@ inline params parse_args(int argc, char *argv[]) {
                     break;
                 }
                 result.action = action_type::dump;
+            } else if (arg == "--scan"sv) {
+                if (result.action != action_type::unspecified && result.action != action_type::scan) {
+                    fprintf(stderr, "Conflicting action '%s'\n", arg.data());
+                    break;
+                }
+                result.action = action_type::scan;
             } else if (arg.starts_with("--format="sv)) {
                 auto format_char = arg["--format="sv.length()];
                 result.format = format_char_to_spec(format_char);
@@ -137,7 +145,9 @@ inline params parse_args(int argc, char *argv[]) {
                 break;
             }
         } else {
-            if (result.action == action_type::dump) {
+            if (result.action == action_type::scan) {
+                result.files.push_back(argv[i]);
+            } else if (result.action == action_type::dump) {
                 unsigned bus = 0xFFFFFFFFU, addr = 0xFFFFFFFFU, index = 0xFFFFFFFFU;
                 char char_type {};
                 auto r = std::sscanf(argv[i], "%u:%u:%c:%u", &bus, &addr, &char_type, &index);
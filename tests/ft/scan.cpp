@@ -0,0 +1,59 @@
+/* Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ft/scan.cpp - batch scanner of configuration descriptor dumps
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "scan.hpp"
+
+namespace usbplusplus {
+namespace ft {
+
+namespace {
+
+constexpr uint8_t interface_type = static_cast<uint8_t>(DescriptorType_t::INTERFACE);
+constexpr uint8_t endpoint_type = static_cast<uint8_t>(DescriptorType_t::ENDPOINT);
+
+// Follows the chain of one dump, appending positions of its descriptors
+blob_index scan_one(std::span<const uint8_t> dump, std::vector<uint16_t>& positions) {
+    blob_index result {};
+    result.first = static_cast<uint32_t>(positions.size());
+    result.error = parse::validate_header(dump);
+    if (result.error != parse::error_t::none) return result;
+    const std::size_t total = parse::detail::total_length(dump);
+    std::size_t pos = 0;
+    unsigned interfaces = 0;
+    unsigned endpoints = 0;
+    while (pos < total) {
+        const std::size_t length = dump[pos];
+        if (length < 2 || pos + length > total) {
+            result.error = parse::error_t::bad_length;
+            break;
+        }
+        positions.push_back(static_cast<uint16_t>(pos));
+        interfaces += dump[pos + 1] == interface_type;
+        endpoints += dump[pos + 1] == endpoint_type;
+        pos += length;
+    }
+    result.count = static_cast<uint16_t>(positions.size() - result.first);
+    result.interfaces = static_cast<uint16_t>(interfaces);
+    result.endpoints = static_cast<uint16_t>(endpoints);
+    return result;
+}
+
+} // namespace
+
+corpus_index scan(std::span<const uint8_t> corpus, std::span<const blob_ref> refs) {
+    corpus_index result {};
+    result.blobs.reserve(refs.size());
+    // a typical descriptor is 7 to 9 bytes long
+    result.positions.reserve(corpus.size() / 8);
+    for (const auto& ref : refs)
+        result.blobs.push_back(scan_one(corpus.subspan(ref.offset, ref.size), result.positions));
+    return result;
+}
+
+} // namespace ft
+} // namespace usbplusplus
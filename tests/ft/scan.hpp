@@ -0,0 +1,54 @@
+/* Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ft/scan.hpp - batch scanner of configuration descriptor dumps
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <usbplusplus/parse.hpp>
+
+namespace usbplusplus {
+namespace ft {
+
+// Location of one configuration dump in a corpus
+struct blob_ref {
+    uint32_t offset;
+    uint32_t size;
+};
+
+// Outcome of scanning one dump
+struct blob_index {
+    uint32_t first;       // index of the first descriptor position in corpus_index::positions
+    uint16_t count;       // number of descriptors, up to the first malformed one
+    uint16_t interfaces;  // number of interface descriptors, including alternate settings
+    uint16_t endpoints;   // number of endpoint descriptors
+    parse::error_t error; // same as parse::validate would return
+};
+
+// Index of a corpus of configuration dumps
+class corpus_index {
+public:
+    std::vector<blob_index> blobs {};
+    std::vector<uint16_t> positions {}; // offsets of descriptors within their dumps
+    // Descriptor n of the dump, n < blobs[blob].count
+    parse::descriptor descriptor(std::span<const uint8_t> corpus, std::span<const blob_ref> refs,
+                                 std::size_t blob, std::size_t n) const {
+        const auto dump = corpus.subspan(refs[blob].offset, refs[blob].size);
+        const auto position = positions[blobs[blob].first + n];
+        return parse::descriptor{dump.subspan(position, dump[position])};
+    }
+};
+
+// Validates and indexes descriptor chains of all dumps in the corpus
+corpus_index scan(std::span<const uint8_t> corpus, std::span<const blob_ref> refs);
+
+} // namespace ft
+} // namespace usbplusplus
@@ -117,4 +117,5 @@ constexpr const  Device_Qualifier deviceQualifier = {
 // Creates USB 1.0 device (per deviceDescriptor.bcdUsb)
 static usbdevice test1 { devaddr::test1, deviceDescriptor, MyStrings{}, TestUAC2Configuration_1, TestUAC2Configuration_2 };
 // Creates USB 2.0 device per deviceDescriptor_2.bcdUsb) with a DeviceQualifier and multilingual strings Matrix.
-static usbdevice test2 { devaddr::test2, deviceDescriptor_2, deviceQualifier, Matrix{}, TestUAC2Configuration_2, TestUAC2Configuration_3 };
+static usbdevice test2 { devaddr::test2, deviceDescriptor_2, deviceQualifier, Matrix{},
+    indexed<TestUAC2Configuration_2>{}, indexed<TestUAC2Configuration_3>{} };
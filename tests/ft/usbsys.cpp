@@ -20,9 +20,16 @@
 #include <source_location>
 #include <functional>
 #include <vector>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <queue>
 #include <tuple>
+#include <algorithm>
 #include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 
 #pragma GCC diagnostic ignored "-Wold-style-cast" // casts from libusb macros
 
@@ -43,9 +50,11 @@ struct device_item {
     device_qualifier_data device_qualifier;
     descriptor_vect configurations_descriptors;
     string_getter strings;
+    std::vector<interface_locator> interface_locators;
     std::source_location location;
     uint8_t active_config_index {};
     std::vector<AlternateSetting> alternate_settings {};
+    std::map<uint8_t, endpoint_model*> endpoints {};
 };
 
 auto& device_list() { // COFU
@@ -100,10 +109,159 @@ unsigned long make_session_id(device_info info) {
     return static_cast<unsigned long>(info.bus_number.get() << 8 | static_cast<uint8_t>(info.device_address));
 }
 
+// Finds a descriptor of the given type in the configuration, for which match returns true
+bool contains_descriptor(const descriptor_data& config, DescriptorType_t type, auto match) {
+    for (std::size_t pos = 0; pos + 2 <= config.size() && config[pos] != 0; pos += config[pos]) {
+        if (config[pos + 1] == static_cast<uint8_t>(type) && match(&config[pos]))
+            return true;
+    }
+    return false;
+}
+
+// Simulated delay between submission and completion of a transfer, FT_LATENCY_US or zero
+std::atomic<long long>& latency_us() {
+    static std::atomic<long long> latency { std::getenv("FT_LATENCY_US") ? std::atoll(std::getenv("FT_LATENCY_US")) : 0 };
+    return latency;
+}
+
+// Runs the callback of the transfer, which sets the flag libusb synchronous API
+// waits for, then wakes the event loop. user_data belongs to the caller and may
+// be null for asynchronous transfers, the transfer may be freed by the callback.
+// A cancelled transfer is reported as cancelled or timed out, as libusb decides
+void complete_transfer(usbi_transfer *itransfer, libusb_transfer_status status) {
+    libusb_context* ctx = itransfer->dev->ctx;
+    if (status == LIBUSB_TRANSFER_CANCELLED)
+        usbi_handle_transfer_cancellation(itransfer);
+    else
+        usbi_handle_transfer_completion(itransfer, status);
+    usbi_signal_event(&ctx->event);
+}
+
+// Completes transfers on a single worker thread in the order of their due time.
+// Submitters never take a lock: a bounded ring, where each cell's sequence tells
+// whether it is free for the producer at a position or ready for the consumer.
+// The worker moves submitted transfers to a heap, so that a transfer, due later,
+// e.g. on a rate limited endpoint, does not hold back transfers, due earlier
+class completion_queue {
+public:
+    using clock = std::chrono::steady_clock;
+    completion_queue() : cells_{}, head_{}, tail_{}, signal_{}, worker_{[this](std::stop_token stop) { run(stop); }} {
+        for (std::size_t i = 0; i < capacity; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    // Completes the transfer with the status at due plus the completion latency
+    void push(usbi_transfer* transfer, clock::time_point due = clock::now(),
+              libusb_transfer_status status = LIBUSB_TRANSFER_COMPLETED) {
+        const item value { transfer, due + std::chrono::microseconds{latency_us().load(std::memory_order_relaxed)},
+                           status, 0 };
+        while (!try_push(value))
+            std::this_thread::yield();
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+    }
+private:
+    static constexpr std::size_t capacity = 256;
+    // Longest time a transfer, submitted while others wait for their due time, stays in the ring
+    static constexpr std::chrono::microseconds poll_interval{100};
+    struct item {
+        usbi_transfer* transfer;
+        clock::time_point due;
+        libusb_transfer_status status;
+        std::size_t order; // of submission, among transfers with the same due time
+    };
+    struct later {
+        bool operator()(const item& l, const item& r) const {
+            return l.due != r.due ? l.due > r.due : l.order > r.order;
+        }
+    };
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        item value;
+    };
+    bool try_push(const item& value) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cells_[pos % capacity];
+            const auto diff = static_cast<std::ptrdiff_t>(c.sequence.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.value = value;
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    bool try_pop(item& value) {
+        cell& c = cells_[head_ % capacity];
+        if (c.sequence.load(std::memory_order_acquire) != head_ + 1)
+            return false;
+        value = c.value;
+        c.sequence.store(head_ + capacity, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+    void run(std::stop_token stop) {
+        std::stop_callback wake{stop, [this] {
+            signal_.fetch_add(1, std::memory_order_release);
+            signal_.notify_one();
+        }};
+        std::priority_queue<item, std::vector<item>, later> pending {};
+        std::size_t order = 0;
+        item value {};
+        while (!stop.stop_requested()) {
+            const auto signal = signal_.load(std::memory_order_acquire);
+            while (try_pop(value)) {
+                value.order = order++;
+                pending.push(value);
+            }
+            const auto now = clock::now();
+            if (pending.empty()) {
+                signal_.wait(signal, std::memory_order_acquire);
+            } else if (now < pending.top().due) {
+                std::this_thread::sleep_until(std::min(pending.top().due, now + poll_interval));
+            } else {
+                const auto [transfer, due, status, position] = pending.top();
+                pending.pop();
+                complete_transfer(transfer, status);
+            }
+        }
+    }
+    std::array<cell, capacity> cells_;
+    std::size_t head_; // owned by the worker
+    std::atomic<std::size_t> tail_;
+    std::atomic<unsigned> signal_;
+    std::jthread worker_;
+};
+
+completion_queue& completions() { // COFU
+    static completion_queue queue{};
+    return queue;
+}
+
+// IN transfers, NAKed by their endpoint models, in the order of submission
+struct pending_list {
+    std::mutex mutex;
+    std::map<endpoint_model*, std::deque<usbi_transfer*>> transfers;
+};
+
+pending_list& pending_transfers() { // COFU
+    static pending_list list{};
+    return list;
+}
+
+}
+
+void usbsys::completion_latency(std::chrono::microseconds latency) {
+    latency_us().store(latency.count(), std::memory_order_relaxed);
 }
 
 void usbsys::add(device_info info, std::source_location loc, descriptor devdescr, descriptor qualifier, descriptor_list configs,
-        string_getter strgetter) {
+        string_getter strgetter, interface_locator_list locators) {
     const auto found = device_list().find(info.device_address);
     if( found != device_list().end() )
         throw std::logic_error{ "USB device address " + std::to_string(static_cast<unsigned>(info.device_address)) +
@@ -122,6 +280,7 @@ void usbsys::add(device_info info, std::source_location loc, descriptor devdescr
         make_device_quaifier_data(qualifier),
         make_descriptor_vect(configs),
         strgetter,
+        locators,
         loc,
         0U
     });
@@ -131,6 +290,20 @@ void usbsys::remove(devaddr addr) {
     device_list().erase(device_list().find(addr));
 }
 
+void usbsys::attach(devaddr addr, uint8_t endpoint_address, endpoint_model& model, std::source_location loc) {
+    auto& dev = device_list().at(addr);
+    const auto declared = std::any_of(dev.configurations_descriptors.begin(), dev.configurations_descriptors.end(),
+        [endpoint_address](const auto& config) {
+            return contains_descriptor(config, DescriptorType_t::ENDPOINT, [endpoint_address](const uint8_t* descr) {
+                return descr[2] == endpoint_address;
+            });
+        });
+    if (!declared)
+        throw std::logic_error{ "Endpoint " + std::to_string(endpoint_address) + " attached at " + loc +
+                " is not declared in the configurations" };
+    dev.endpoints[endpoint_address] = &model;
+}
+
 static int get_device_list(struct libusb_context *ctx, struct discovered_devs **discdevs) {
     for(const auto& d : device_list()) {
         libusb_device *dev = usbi_alloc_device(ctx, make_session_id(d.second.info));
@@ -231,8 +404,13 @@ static auto get_string(ControlPacket packet, device_item& dev, response resp) {
     return true;
 }
 
-static auto get_interface_descriptor(ControlPacket, device_item&, response) {
-    // not used in functional tests
+static auto get_interface_descriptor(ControlPacket packet, device_item& dev, response resp) {
+    if (dev.active_config_index >= dev.interface_locators.size() || !dev.interface_locators[dev.active_config_index])
+        return true;
+    const unsigned number = packet.descriptor_index();
+    const unsigned alternate = number < dev.alternate_settings.size() ? dev.alternate_settings[number].get() : 0u;
+    if (auto descr = dev.interface_locators[dev.active_config_index](number, alternate))
+        resp.send(packet.wLength.get(), descr);
     return true;
 }
 
@@ -284,35 +462,136 @@ using request_dispatcher = dispatch::dispatcher<
     dispatch::to<set_interface, dispatch::when<RequestCode_t::SET_INTERFACE>{}>
 >;
 
+static int submit_control_transfer(usbi_transfer *itransfer, libusb_transfer& transfer, device_item& dev) {
+    const ControlPacket& packet = *reinterpret_cast<ControlPacket*>(transfer.buffer);
+    int error = LIBUSB_SUCCESS;
+    if (!request_dispatcher{}(packet, dev, response{libusb_control_transfer_get_data(&transfer), itransfer->transferred, error})) {
+        error = LIBUSB_ERROR_NOT_SUPPORTED;
+    }
+    transfer.actual_length = itransfer->transferred;
+    completions().push(itransfer);
+    return error;
+}
+
+// Passes the transfer to the endpoint model as a whole, returns false if the model NAKs it
+static bool try_data_transfer(usbi_transfer *itransfer, endpoint_model& model) {
+    libusb_transfer& transfer = *USBI_TRANSFER_TO_LIBUSB_TRANSFER(itransfer);
+    const auto size = model.transfer(transfer.endpoint, { transfer.buffer, static_cast<std::size_t>(transfer.length) });
+    if (size == endpoint_model::nak)
+        return false;
+    itransfer->transferred = static_cast<int>(size);
+    transfer.actual_length = itransfer->transferred;
+    completions().push(itransfer, model.due(size, completion_queue::clock::now()));
+    return true;
+}
+
+// Bulk and interrupt transfers are passed to the endpoint model as a whole. A NAKed IN transfer waits,
+// behind earlier ones, until a transfer to the same model, e.g. OUT to a loopback, gives it data
+static int submit_data_transfer(usbi_transfer *itransfer, libusb_transfer& transfer, endpoint_model& model) {
+    auto& pending = pending_transfers();
+    std::lock_guard lock{pending.mutex};
+    auto& waiting = pending.transfers[&model];
+    const bool behind = !waiting.empty() && (transfer.endpoint & LIBUSB_ENDPOINT_IN);
+    if (behind || !try_data_transfer(itransfer, model)) {
+        waiting.push_back(itransfer);
+        return LIBUSB_SUCCESS;
+    }
+    while (!waiting.empty() && try_data_transfer(waiting.front(), model))
+        waiting.pop_front();
+    return LIBUSB_SUCCESS;
+}
+
+// Completes a NAKed transfer as cancelled, a transfer, already completing, is not found
+static int cancel_transfer(usbi_transfer *itransfer) {
+    auto& pending = pending_transfers();
+    std::lock_guard lock{pending.mutex};
+    for (auto& [model, waiting] : pending.transfers) {
+        const auto found = std::find(waiting.begin(), waiting.end(), itransfer);
+        if (found != waiting.end()) {
+            waiting.erase(found);
+            completions().push(itransfer, completion_queue::clock::now(), LIBUSB_TRANSFER_CANCELLED);
+            return LIBUSB_SUCCESS;
+        }
+    }
+    return LIBUSB_ERROR_NOT_FOUND;
+}
+
+// Isochronous transfers are passed to the endpoint model packet by packet, a NAKed packet is empty
+static int submit_iso_transfer(usbi_transfer *itransfer, libusb_transfer& transfer, endpoint_model& model) {
+    std::size_t offset = 0;
+    std::size_t total = 0;
+    for (int i = 0; i < transfer.num_iso_packets; ++i) {
+        auto& packet = transfer.iso_packet_desc[i];
+        auto size = model.transfer(transfer.endpoint, { transfer.buffer + offset, packet.length });
+        if (size == endpoint_model::nak)
+            size = 0;
+        packet.actual_length = static_cast<unsigned>(size);
+        packet.status = LIBUSB_TRANSFER_COMPLETED;
+        offset += packet.length;
+        total += size;
+    }
+    itransfer->transferred = static_cast<int>(total);
+    transfer.actual_length = itransfer->transferred;
+    completions().push(itransfer, model.due(total, completion_queue::clock::now()));
+    return LIBUSB_SUCCESS;
+}
+
 static int submit_transfer(usbi_transfer *itransfer) {
     if (itransfer->dev == nullptr) {
         return LIBUSB_ERROR_INVALID_PARAM;
     }
     libusb_transfer& transfer = *USBI_TRANSFER_TO_LIBUSB_TRANSFER(itransfer);
-    if (transfer.type != LIBUSB_TRANSFER_TYPE_CONTROL) {
-        return LIBUSB_ERROR_NOT_SUPPORTED;
-    }
-
     auto found = device_list().find(devaddr(itransfer->dev->device_address));
     if (found == device_list().end()) {
         return LIBUSB_ERROR_NOT_FOUND;
     }
-
-    const ControlPacket& packet = *reinterpret_cast<ControlPacket*>(transfer.buffer);
-    int error = LIBUSB_SUCCESS;
-    if (!request_dispatcher{}(packet, found->second, response{libusb_control_transfer_get_data(&transfer), itransfer->transferred, error})) {
-        error = LIBUSB_ERROR_NOT_SUPPORTED;
+    if (transfer.type == LIBUSB_TRANSFER_TYPE_CONTROL) {
+        return submit_control_transfer(itransfer, transfer, found->second);
     }
-    std::thread complete_transfer_later{[](usbi_transfer *itrans, libusb_transfer* trans) {
-        using namespace std::literals;
-        std::this_thread::sleep_for(1ms);
-        *static_cast<int*>(trans->user_data) = 1;
-        usbi_signal_event(&itrans->dev->ctx->event);
-        usbi_handle_transfer_completion(itrans, LIBUSB_TRANSFER_COMPLETED);
-    }, itransfer, &transfer};
-    complete_transfer_later.detach();
-    transfer.actual_length = itransfer->transferred;
-    return error;
+    auto model = found->second.endpoints.find(transfer.endpoint);
+    if (model == found->second.endpoints.end()) {
+        return LIBUSB_ERROR_NOT_SUPPORTED;
+    }
+    switch (transfer.type) {
+    case LIBUSB_TRANSFER_TYPE_BULK:
+    case LIBUSB_TRANSFER_TYPE_INTERRUPT:
+        return submit_data_transfer(itransfer, transfer, *model->second);
+    case LIBUSB_TRANSFER_TYPE_ISOCHRONOUS:
+        return submit_iso_transfer(itransfer, transfer, *model->second);
+    default:
+        return LIBUSB_ERROR_NOT_SUPPORTED;
+    }
+}
+
+static int claim_interface(libusb_device_handle* dev_handle, uint8_t number) {
+    auto found = device_list().find(devaddr(dev_handle->dev->device_address));
+    if (found == device_list().end())
+        return LIBUSB_ERROR_NO_DEVICE;
+    const auto& dev = found->second;
+    if (dev.active_config_index >= dev.configurations_descriptors.size())
+        return LIBUSB_ERROR_NOT_FOUND;
+    const bool declared = contains_descriptor(dev.configurations_descriptors[dev.active_config_index],
+        DescriptorType_t::INTERFACE, [number](const uint8_t* descr) { return descr[2] == number; });
+    return declared ? LIBUSB_SUCCESS : LIBUSB_ERROR_NOT_FOUND;
+}
+
+static int set_interface_altsetting(libusb_device_handle* dev_handle, uint8_t number, uint8_t alternate) {
+    auto found = device_list().find(devaddr(dev_handle->dev->device_address));
+    if (found == device_list().end())
+        return LIBUSB_ERROR_NO_DEVICE;
+    if (found->second.active_config_index >= found->second.configurations_descriptors.size())
+        return LIBUSB_ERROR_NOT_FOUND;
+    const bool declared = contains_descriptor(found->second.configurations_descriptors[found->second.active_config_index],
+        DescriptorType_t::INTERFACE, [number, alternate](const uint8_t* descr) {
+            return descr[2] == number && descr[3] == alternate;
+        });
+    if (!declared)
+        return LIBUSB_ERROR_NOT_FOUND;
+    auto& settings = found->second.alternate_settings;
+    if (number >= settings.size())
+        settings.resize(number + 1u, AlternateSetting(0));
+    settings[number] = AlternateSetting(alternate);
+    return LIBUSB_SUCCESS;
 }
 
 static int open_device(libusb_device_handle* ludh){
@@ -338,10 +617,10 @@ const struct usbi_os_backend usbi_backend = {
     .get_config_descriptor_by_value = get_config_descriptor_by_value,
     .get_configuration = get_configuration,
     .set_configuration = set_configuration,
-    .claim_interface = [](libusb_device_handle*, uint8_t)->int { return LIBUSB_ERROR_NOT_SUPPORTED; },
-    .release_interface = [](libusb_device_handle*, uint8_t)->int { return LIBUSB_ERROR_NOT_SUPPORTED; },
-    .set_interface_altsetting = [](libusb_device_handle*, uint8_t,  uint8_t)->int { return LIBUSB_ERROR_NOT_SUPPORTED; },
-    .clear_halt = [](libusb_device_handle*, unsigned char)->int { return LIBUSB_ERROR_NOT_SUPPORTED; },
+    .claim_interface = claim_interface,
+    .release_interface = [](libusb_device_handle*, uint8_t)->int { return LIBUSB_SUCCESS; },
+    .set_interface_altsetting = set_interface_altsetting,
+    .clear_halt = [](libusb_device_handle*, unsigned char)->int { return LIBUSB_SUCCESS; },
     .submit_transfer = submit_transfer,
-    .cancel_transfer = [](usbi_transfer*)->int { return LIBUSB_SUCCESS; },
+    .cancel_transfer = cancel_transfer,
 };
@@ -8,10 +8,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <deque>
 #include <initializer_list>
+#include <mutex>
 #include <span>
 #include <stdexcept>
 #include <source_location>
@@ -32,6 +36,8 @@ namespace ft {
 using descriptor = std::span<const std::uint8_t>;
 using descriptor_list = std::initializer_list<descriptor>;
 using string_getter = const uint8_t* (*)(Index::type index, LanguageIdentifier);
+using interface_locator = const uint8_t* (*)(unsigned number, unsigned alternate);
+using interface_locator_list = std::initializer_list<interface_locator>;
 
 enum class libusbspeed : uint8_t {
     unknown, low, full, high, super, super_plus, super_plus_x2
@@ -58,13 +64,110 @@ inline std::string operator+(const std::string& lhs, std::source_location locati
     return str;
 }
 
+// Emulated function of a bulk, interrupt or isochronous endpoint
+class endpoint_model {
+public:
+    using clock = std::chrono::steady_clock;
+    // Returned by transfer for an IN transfer while the model has no data, as a device NAKs the IN token.
+    // The transfer stays pending until a transfer to the same model gives it data or it is cancelled
+    static constexpr std::size_t nak = SIZE_MAX;
+    endpoint_model() = default;
+    endpoint_model(const endpoint_model&) = delete;
+    endpoint_model& operator=(const endpoint_model&) = delete;
+    virtual ~endpoint_model() = default;
+    // Consumes data of an OUT transfer or fills data of an IN transfer, returns number of bytes transferred
+    virtual std::size_t transfer(uint8_t endpoint_address, std::span<uint8_t> data) = 0;
+    // Time, when a transfer of size bytes, submitted at now, is done on the bus, before the completion latency.
+    // Called once per transfer, a model, busy with earlier transfers, returns a time past them
+    virtual clock::time_point due(std::size_t /*size*/, clock::time_point now) { return now; }
+protected:
+    static constexpr bool is_in(uint8_t endpoint_address) { return endpoint_address & 0x80; }
+};
+
+// Accepts and discards all OUT data, NAKs all IN transfers
+class sink_endpoint final : public endpoint_model {
+public:
+    std::size_t transfer(uint8_t endpoint_address, std::span<uint8_t> data) override {
+        if (is_in(endpoint_address)) return nak;
+        received_ += data.size();
+        return data.size();
+    }
+    std::size_t received() const { return received_; }
+private:
+    std::size_t received_ {};
+};
+
+// Fills IN transfers with an incrementing byte pattern, accepts no OUT data
+class source_endpoint final : public endpoint_model {
+public:
+    std::size_t transfer(uint8_t endpoint_address, std::span<uint8_t> data) override {
+        if (!is_in(endpoint_address)) return 0;
+        for (auto& byte : data)
+            byte = next_++;
+        return data.size();
+    }
+private:
+    uint8_t next_ {};
+};
+
+// Returns OUT data in the following IN transfers, holding at most capacity bytes, NAKs IN transfers while empty
+class loopback_endpoint final : public endpoint_model {
+public:
+    explicit loopback_endpoint(std::size_t capacity = 1 << 20) : mutex_{}, data_{}, capacity_{capacity} {}
+    std::size_t transfer(uint8_t endpoint_address, std::span<uint8_t> data) override {
+        std::lock_guard lock{mutex_};
+        if (is_in(endpoint_address)) {
+            if (data_.empty()) return nak;
+            const auto size = std::min(data.size(), data_.size());
+            std::copy_n(data_.begin(), size, data.begin());
+            data_.erase(data_.begin(), data_.begin() + static_cast<std::ptrdiff_t>(size));
+            return size;
+        }
+        const auto size = std::min(data.size(), capacity_ - data_.size());
+        data_.insert(data_.end(), data.begin(), data.begin() + static_cast<std::ptrdiff_t>(size));
+        return size;
+    }
+private:
+    std::mutex mutex_;
+    std::deque<uint8_t> data_;
+    std::size_t capacity_;
+};
+
+// Limits throughput of another model to bytes_per_second. Transfers occupy the model one after another,
+// so that overlapping transfers, in any direction, share the rate
+class rate_limited_endpoint final : public endpoint_model {
+public:
+    rate_limited_endpoint(endpoint_model& model, std::size_t bytes_per_second)
+      : model_{model}, bytes_per_second_{bytes_per_second}, mutex_{}, busy_until_{} {}
+    std::size_t transfer(uint8_t endpoint_address, std::span<uint8_t> data) override {
+        return model_.transfer(endpoint_address, data);
+    }
+    clock::time_point due(std::size_t size, clock::time_point now) override {
+        const auto nanoseconds = size * 1'000'000'000ull / bytes_per_second_;
+        std::lock_guard lock{mutex_};
+        busy_until_ = std::max(model_.due(size, now), busy_until_) +
+                      std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(nanoseconds)};
+        return busy_until_;
+    }
+private:
+    endpoint_model& model_;
+    std::size_t bytes_per_second_;
+    std::mutex mutex_;
+    clock::time_point busy_until_;
+};
+
 // Implements USB "bus"
 class usbsys final {
 public:
+    // Simulated delay between submission and completion of a transfer,
+    // zero by default or FT_LATENCY_US microseconds if set in the environment
+    static void completion_latency(std::chrono::microseconds);
 private:
     static constexpr uint8_t first_test_bus_id = 240; // to avoid collision with real USB bus
-    static void add(device_info, std::source_location loc, descriptor, descriptor, descriptor_list, string_getter);
+    static void add(device_info, std::source_location loc, descriptor, descriptor, descriptor_list, string_getter,
+                    interface_locator_list);
     static void remove(devaddr);
+    static void attach(devaddr, uint8_t endpoint_address, endpoint_model&, std::source_location loc);
     static constexpr device_info make_device_info(devaddr device_address, BCD bcdusb) {
         return {
             device_address,
@@ -84,6 +187,27 @@ private:
     friend class usbdevice;
 };
 
+// Configuration with its ConfigurationIndex, lets the backend answer GET_DESCRIPTOR(INTERFACE)
+// Usage: usbdevice dev { address, device, strings, indexed<configuration>{} };
+template<const auto& Config>
+struct indexed {
+    static const uint8_t* ptr() { return Config.ptr(); }
+    static constexpr auto length() { return Config.length(); }
+    static constexpr auto totallength() { return Config.totallength(); }
+    static const uint8_t* interface(unsigned number, unsigned alternate) {
+        return ConfigurationIndex<Config>::interface(number, alternate);
+    }
+};
+
+template<typename Configuration>
+constexpr interface_locator locator_of() {
+    if constexpr (requires { Configuration::interface(0u, 0u); }) {
+        return Configuration::interface;
+    } else {
+        return nullptr;
+    }
+}
+
 struct address_with_location {
     address_with_location(devaddr addr, std::source_location loc= std::source_location::current())
       : address{addr}, location{loc} {}
@@ -115,7 +239,8 @@ public:
           { dev.ptr(), dev.length() },
           { },
           { {config.ptr(), config.totallength() } ... },
-          Strings::get);
+          Strings::get,
+          { locator_of<Configurations>() ... });
     }
     usbdevice(address_with_location addr, const usb2::Device& dev, const usb2::Device_Qualifier& qualifier, Strings,
             const Configurations& ... config)
@@ -127,11 +252,17 @@ public:
             { dev.ptr(), dev.length() },
             { qualifier.ptr(), qualifier.length() },
             { {config.ptr(), config.totallength() } ... },
-            Strings::get);
+            Strings::get,
+            { locator_of<Configurations>() ... });
     }
     ~usbdevice() {
         usbsys::remove(address_.address);
     }
+    // Handles transfers to or from the endpoint, declared in any of the configurations, with the model
+    void attach(uint8_t endpoint_address, endpoint_model& model,
+                std::source_location loc = std::source_location::current()) {
+        usbsys::attach(address_.address, endpoint_address, model, loc);
+    }
 private:
     static void check_config_count(std::size_t count, std::source_location location) {
         if (count != sizeof...(Configurations)) {
@@ -14,6 +14,7 @@ using namespace usbplusplus;
 using namespace usbplusplus::usb2;
 using namespace usbplusplus::ut;
 using namespace usbplusplus::usb2::tests;
+using namespace usbplusplus::usb3::tests;
 using namespace boost::ut;
 
 namespace {
@@ -38,6 +39,12 @@ constexpr bytes<71> uac2_configuration3 {
  0x01, 0x00, 0x01, 0x01, 0x07, 0x05, 0x04, 0x01, 0x00, 0x01, 0x01
 };
 
+constexpr bytes<44> storage_configuration {
+ 0x09, 0x02, 0x2C, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x09, 0x04, 0x00, 0x00, 0x02, 0x08, 0x06, 0x50, 0x00, 0x07, 0x05,
+ 0x81, 0x02, 0x00, 0x04, 0x00, 0x06, 0x30, 0x0F, 0x04, 0x00, 0x00, 0x07, 0x05, 0x02, 0x02, 0x00, 0x04, 0x00, 0x06, 0x30,
+ 0x0F, 0x04, 0x00, 0x00
+};
+
 } // namespace expected
 
 suite<"Configuration Descriptor"> configuration_descriptor_suite = [] {
@@ -51,6 +58,26 @@ suite<"Configuration Descriptor"> configuration_descriptor_suite = [] {
     "UAC3 Configuration3 Descriptor"_test = [] {
         expect(eq(TestUAC2Configuration_3, expected::uac2_configuration3));
     };
+    "Counted interfaces"_test = [] {
+        auto configuration = TestUAC2Configuration_3;
+        configuration.bNumInterfaces = 0;
+        expect(eq(count_interfaces(configuration), expected::uac2_configuration3));
+    };
+    "SuperSpeed Configuration Descriptor"_test = [] {
+        expect(eq(TestStorageConfiguration, expected::storage_configuration));
+    };
+};
+
+suite<"Configuration Index"> configuration_index_suite = [] {
+    using Index3 = ConfigurationIndex<TestUAC2Configuration_3>;
+    "Interface descriptor"_test = [] {
+        expect(eq(Index3::interface(2, 1), bytes<9>{ 0x09, 0x04, 0x02, 0x01, 0x02, 0x01, 0x00, 0x00, 0x00 }));
+        expect(Index3::interface(2, 0) == nullptr);
+    };
+    "Endpoint descriptor"_test = [] {
+        expect(eq(Index3::endpoint(0x83), bytes<7>{ 0x07, 0x05, 0x83, 0x01, 0x00, 0x01, 0x01 }));
+        expect(Index3::endpoint(0x03) == nullptr);
+    };
 };
 } // namespace
 
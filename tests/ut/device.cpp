@@ -14,6 +14,7 @@ using namespace usbplusplus::usb2;
 using namespace usbplusplus::ut;
 using namespace usbplusplus::usb1::tests;
 using namespace usbplusplus::usb2::tests;
+using namespace usbplusplus::usb3::tests;
 using namespace boost::ut;
 
 namespace {
@@ -30,6 +31,11 @@ constexpr bytes<18> device_2_00_descriptor {
 constexpr bytes<10> device_qualifier {
     0x0A, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0x01, 0x00
 };
+
+constexpr bytes<22> bos_descriptor {
+    0x05, 0x0F, 0x16, 0x00, 0x02, 0x07, 0x10, 0x02, 0x02, 0x00, 0x00, 0x00,
+    0x0A, 0x10, 0x03, 0x00, 0x0E, 0x00, 0x01, 0x0A, 0xFF, 0x07
+};
 } // namespace expected
 
 suite<"Device Descriptor"> device_descriptor_suite = [] {
@@ -42,6 +48,9 @@ suite<"Device Descriptor"> device_descriptor_suite = [] {
     "Device Qualifier"_test = [] {
         expect(eq(TestDeviceQualifier_1_0, expected::device_qualifier));
     };
+    "BOS Descriptor"_test = [] {
+        expect(eq(TestBOS_3_20, expected::bos_descriptor));
+    };
 };
 
 }
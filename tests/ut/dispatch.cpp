@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ut/dispatch.cpp - unit tests for request dispatching
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/dispatch.hpp>
+#include <usbplusplus/cdc.hpp>
+#include "configurations.hpp"
+#include "ut.hpp"
+
+using namespace usbplusplus;
+using namespace boost::ut;
+
+namespace {
+
+constexpr StandardDeviceRequest make_request(Recipient_t recipient, RequestCode_t code, uint16_t value) {
+    return {{ RequestType(DataTransferDirection_t::Device_to_Host, RequestType_t::Standard, recipient),
+              code, value, 0, 64 }};
+}
+
+constexpr StandardDeviceRequest get_descriptor(DescriptorType_t type) {
+    return make_request(Recipient_t::Device, RequestCode_t::GET_DESCRIPTOR,
+                        static_cast<uint16_t>(static_cast<unsigned>(type) << 8));
+}
+
+constexpr StandardDeviceRequest class_request(Recipient_t recipient, cdc::CdcRequestCode_t code, uint8_t index) {
+    return {{ RequestType(DataTransferDirection_t::Host_to_device, RequestType_t::Class, recipient),
+              static_cast<RequestCode_t>(code), 0, index, 0 }};
+}
+
+template<int Id>
+bool handler(StandardDeviceRequest, int& handled) {
+    handled = Id;
+    return true;
+}
+
+template<template<typename...> class Dispatcher>
+using test_dispatcher = Dispatcher<
+    dispatch::to<handler<1>, dispatch::when<DescriptorType_t::DEVICE>{}>,
+    dispatch::to<handler<2>, dispatch::when<DescriptorType_t::CONFIGURATION>{}>,
+    dispatch::to<handler<3>, dispatch::when<RequestCode_t::GET_STATUS, Recipient_t::Interface>{}>,
+    dispatch::to<handler<4>, dispatch::when<RequestCode_t::GET_STATUS>{}>,
+    dispatch::to<handler<6>, dispatch::when<DescriptorType_t::STRING>{}>,
+    dispatch::to<handler<5>, dispatch::when<RequestCode_t::GET_DESCRIPTOR>{}>
+>;
+
+template<template<typename...> class Dispatcher>
+int dispatch_to(StandardDeviceRequest request) {
+    int handled = 0;
+    return test_dispatcher<Dispatcher>{}(request, handled) ? handled : -1;
+}
+
+suite<"Dispatch"> dispatch_suite = [] {
+    const StandardDeviceRequest requests[] = {
+        get_descriptor(DescriptorType_t::DEVICE),
+        get_descriptor(DescriptorType_t::CONFIGURATION),
+        get_descriptor(DescriptorType_t::STRING),
+        get_descriptor(DescriptorType_t::DEBUG),
+        get_descriptor(static_cast<DescriptorType_t>(0x80)),
+        make_request(Recipient_t::Interface, RequestCode_t::GET_STATUS, 0),
+        make_request(Recipient_t::Endpoint, RequestCode_t::GET_STATUS, 0),
+        make_request(Recipient_t::Device, RequestCode_t::GET_CONFIGURATION, 0),
+        make_request(Recipient_t::Device, static_cast<RequestCode_t>(0x80), 0),
+    };
+    const int expected[] = { 1, 2, 6, 5, 5, 3, 4, -1, -1 };
+    "Fold dispatcher"_test = [&] {
+        for (unsigned i = 0; i < std::size(requests); ++i)
+            expect(eq(dispatch_to<dispatch::dispatcher>(requests[i]), expected[i])) << "request " << i;
+    };
+    "Indexed dispatcher"_test = [&] {
+        for (unsigned i = 0; i < std::size(requests); ++i)
+            expect(eq(dispatch_to<dispatch::indexed_dispatcher>(requests[i]), expected[i])) << "request " << i;
+    };
+};
+
+using cdc_dispatcher = dispatch::dispatcher<
+    dispatch::to<handler<20>, dispatch::when<RequestType_t::Class, Recipient_t::Interface,
+                                             cdc::CdcRequestCode_t::SET_LINE_CODING>{}>,
+    dispatch::to<handler<21>, dispatch::when<RequestType_t::Class, Recipient_t::Interface>{}>
+>;
+
+using test_router = dispatch::router<usb2::tests::TestUAC2Configuration_3,
+    dispatch::on_interface<2, cdc_dispatcher>,
+    dispatch::on_interface<3, dispatch::dispatcher<dispatch::to<handler<30>, dispatch::when<RequestType_t::Class>{}>>>
+>;
+
+int route(StandardDeviceRequest request) {
+    int handled = 0;
+    return test_router{}(request, handled) ? handled : -1;
+}
+
+suite<"Router"> router_suite = [] {
+    using cdc::CdcRequestCode_t;
+    "Interface recipient"_test = [] {
+        expect(eq(route(class_request(Recipient_t::Interface, CdcRequestCode_t::SET_LINE_CODING, 2)), 20));
+        expect(eq(route(class_request(Recipient_t::Interface, CdcRequestCode_t::SEND_BREAK, 2)), 21));
+        expect(eq(route(class_request(Recipient_t::Interface, CdcRequestCode_t::SEND_BREAK, 3)), 30));
+        expect(eq(route(class_request(Recipient_t::Interface, CdcRequestCode_t::SEND_BREAK, 1)), -1));
+        expect(eq(route(class_request(Recipient_t::Interface, CdcRequestCode_t::SEND_BREAK, 9)), -1));
+    };
+    "Endpoint recipient"_test = [] {
+        expect(eq(route(class_request(Recipient_t::Endpoint, CdcRequestCode_t::SEND_BREAK, 0x81)), -1));
+        expect(eq(route(class_request(Recipient_t::Endpoint, CdcRequestCode_t::SEND_BREAK, 0x83)), 30));
+        expect(eq(route(class_request(Recipient_t::Endpoint, CdcRequestCode_t::SEND_BREAK, 0x04)), 30));
+        expect(eq(route(class_request(Recipient_t::Endpoint, CdcRequestCode_t::SEND_BREAK, 0x84)), -1));
+    };
+    "Other recipient"_test = [] {
+        expect(eq(route(class_request(Recipient_t::Device, CdcRequestCode_t::SEND_BREAK, 2)), -1));
+    };
+};
+
+} // namespace
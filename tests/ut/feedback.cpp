@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ut/feedback.cpp - unit tests for feedback generator
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/feedback.hpp>
+#include <vector>
+#include "ut.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::ut;
+using namespace boost::ut;
+
+namespace {
+
+using full_speed = feedback::format<BusSpeed_t::Full>;
+using high_speed = feedback::format<BusSpeed_t::High>;
+
+static_assert(full_speed::of(48000) == 48u << 14, "full_speed::of(48000)");
+static_assert(full_speed::of(44100) == 722534, "full_speed::of(44100)");
+static_assert(high_speed::of(48000) == 6u << 16, "high_speed::of(48000)");
+static_assert(high_speed::of(44100) == 361267, "high_speed::of(44100)");
+
+constexpr usb2::Endpoint Feedback(uint8_t interval, uint16_t size) {
+    return { {}, {}, EndpointAddress(1, EndpointDirection_t::IN),
+        usb2::Endpoint::Attributes(TransferType_t::Isochronous, usb2::SynchronizationType_t::No_Synchronization,
+            usb2::UsageType_t::Feedback_endpoint),
+        MaxPacketSize(size), Interval(interval) };
+}
+
+constexpr usb2::Endpoint full_speed_feedback = Feedback(1, 3);
+constexpr usb2::Endpoint high_speed_feedback = Feedback(1, 4);
+constexpr usb2::Endpoint high_speed_feedback_4 = Feedback(4, 4);
+
+// Bytes of the value, sent to the host
+template<typename Generator>
+std::vector<uint8_t> sent(const Generator& generator) {
+    return { generator.data(), generator.data() + Generator::size };
+}
+
+suite<"Feedback"> feedback_suite = [] {
+    "Encoding"_test = [] {
+        feedback::generator<full_speed_feedback, BusSpeed_t::Full> full { full_speed::of(48000) };
+        expect(eq(sent(full), std::vector<uint8_t>{ 0x00, 0x00, 0x0C }));
+        feedback::generator<high_speed_feedback, BusSpeed_t::High> high { high_speed::of(44100) };
+        expect(eq(sent(high), std::vector<uint8_t>{ 0x33, 0x83, 0x05, 0x00 }));
+    };
+    "Update period"_test = [] {
+        feedback::generator<high_speed_feedback_4, BusSpeed_t::High> generator { high_speed::of(48000) };
+        expect(! generator.sof(0));
+        for(uint32_t frame = 1; frame < 8; ++frame)
+            expect(! generator.sof(frame * 6));
+        expect(generator.sof(48));
+        expect(eq(generator.value(), high_speed::of(48000)));
+    };
+    "Rate of device clock"_test = [] {
+        // 256 fs counter, 12300 ticks per frame, 48.046875 kHz
+        feedback::generator<full_speed_feedback, BusSpeed_t::Full, 4, 8, 8> generator { full_speed::of(48000) };
+        uint32_t ticks = 0;
+        for(unsigned frame = 0; frame < 1000; ++frame, ticks += 12300)
+            generator.sof(ticks);
+        expect(eq(generator.rate(), 12300u << 6));
+    };
+    "Buffer level"_test = [] {
+        feedback::generator<full_speed_feedback, BusSpeed_t::Full, 4, 8> generator { full_speed::of(48000) };
+        generator.occupancy(4);
+        expect(eq(generator.value(), full_speed::of(48000) - (4u << 6)));
+        generator.occupancy(-4);
+        expect(eq(generator.value(), full_speed::of(48000) + (4u << 6)));
+    };
+};
+
+}
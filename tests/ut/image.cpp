@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ut/image.cpp - unit tests for DeviceImage
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <cstring>
+#include "configurations.hpp"
+#include "devices.hpp"
+#include "ut.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::ut;
+using namespace usbplusplus::usb1::tests;
+using namespace usbplusplus::usb2::tests;
+using namespace boost::ut;
+
+namespace {
+
+using Image = DeviceImage<TestStrings, TestDevice_2_00, TestDeviceQualifier_1_0,
+                          TestUAC2Configuration_1, TestUAC2Configuration_2>;
+using MultiImage = DeviceImage<TestMultiStrings, TestDevice_2_00>;
+using SlotImage = DeviceImage<TestSlotMultiStrings, TestDevice_2_00>;
+
+// Whether span holds exactly the bytes of descriptor
+template<typename Descriptor>
+bool same(DescriptorSpan span, const Descriptor& descriptor) {
+    return span.size == sizeof(descriptor) && std::memcmp(span.data, &descriptor, sizeof(descriptor)) == 0;
+}
+
+constexpr bytes<4> string_zero { 0x04, 0x03, 0x09, 0x04 };
+constexpr bytes<8> multi_string_zero { 0x08, 0x03, 0x09, 0x04, 0x09, 0x08, 0x22, 0x04 };
+
+suite<"Device Image"> device_image_suite = [] {
+    "Descriptors"_test = [] {
+        expect(same(Image::get(DescriptorType_t::DEVICE, 0), TestDevice_2_00));
+        expect(same(Image::get(DescriptorType_t::DEVICE_QUALIFIER, 0), TestDeviceQualifier_1_0));
+        expect(same(Image::get(DescriptorType_t::CONFIGURATION, 0), TestUAC2Configuration_1));
+        expect(same(Image::get(DescriptorType_t::CONFIGURATION, 1), TestUAC2Configuration_2));
+        expect(Image::get(DescriptorType_t::CONFIGURATION, 2).empty());
+        expect(Image::get(DescriptorType_t::OTHER_SPEED, 0).empty());
+        expect(eq(Image::get(DescriptorType_t::DEVICE, 0).data, Image::data()));
+        expect(eq(reinterpret_cast<std::uintptr_t>(Image::data()) % Image::alignment, 0u));
+    };
+    "GET_DESCRIPTOR"_test = [] {
+        expect(same(Image::get(0x0200, 0), TestUAC2Configuration_1));
+        expect(same(Image::get(0x0201, 0x0409), TestUAC2Configuration_2));
+        expect(eq(Image::get(0x0300, 0).data, string_zero));
+        expect(eq(Image::get(0x0302, 0x0409).data, u"SuperPuper device"));
+        expect(Image::get(0x0305, 0x0409).empty());
+    };
+    "Strings"_test = [] {
+        expect(eq(Image::get(DescriptorType_t::STRING, 4, LanguageIdentifier::English_United_States).data,
+                  u"SN-12C55F2"));
+        expect(eq(Image::get(DescriptorType_t::STRING, 1, LanguageIdentifier::Ukrainian).data,
+                  u"MegaCool Corp."));
+    };
+    "Multilingual strings"_test = [] {
+        expect(eq(MultiImage::get(DescriptorType_t::STRING, 0).data, multi_string_zero));
+        expect(eq(MultiImage::get(DescriptorType_t::STRING, 2, LanguageIdentifier::English_United_Kingdom).data,
+                  u"SuperDuper device"));
+        expect(eq(MultiImage::get(DescriptorType_t::STRING, 1, LanguageIdentifier::Ukrainian).data,
+                  u"СуперКрута Корп"));
+        expect(eq(MultiImage::get(DescriptorType_t::STRING, 2, LanguageIdentifier::German_Standard).data,
+                  u"SuperPuper device"));
+        expect(MultiImage::get(DescriptorType_t::STRING, 3, LanguageIdentifier::Ukrainian).data ==
+               MultiImage::get(DescriptorType_t::STRING, 3, LanguageIdentifier::English_United_States).data);
+    };
+    "Run time strings"_test = [] {
+        const uint8_t uid[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+        sSerialSlot.hex(uid, sizeof(uid));
+        expect(SlotImage::get(DescriptorType_t::STRING, 2, LanguageIdentifier::Ukrainian).data == sSerialSlot.ptr());
+        expect(eq(SlotImage::get(DescriptorType_t::STRING, 2, LanguageIdentifier::English_United_States).data,
+                  u"DEADBEEF"));
+        expect(eq(SlotImage::get(DescriptorType_t::STRING, 2).size, 18u));
+    };
+};
+} // namespace
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ut/parse.cpp - unit tests for the descriptor parser
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/parse.hpp>
+#include <vector>
+#include "configurations.hpp"
+#include "ut.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::ut;
+using namespace boost::ut;
+
+namespace {
+
+using SpeakerStreaming = uac2::AudioStreaming<List<uac2::Type_I_Format_Type>,
+                                              List<uac2::AS_Isochronous_Audio_Data_Endpoint>>;
+
+// Audio streaming interface, its class-specific header and an isochronous endpoint
+constexpr bytes<32> audio_streaming {
+ 0x09, 0x04, 0x01, 0x01, 0x01, 0x01, 0x02, 0x20, 0x00, 0x10, 0x24, 0x01, 0x05, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x02,
+ 0x03, 0x00, 0x00, 0x00, 0x00, 0x07, 0x05, 0x01, 0x05, 0x00, 0x02, 0x01
+};
+
+suite<"Descriptor Parser"> descriptor_parser_suite = [] {
+    "Configuration"_test = [] {
+        const auto blob = parse::bytes_of(usb2::tests::TestUAC2Configuration_3);
+        const std::vector<uint8_t> dump(blob.begin(), blob.end());
+        const parse::configuration config { dump };
+        expect(config.valid());
+        expect(eq(config.totallength(), dump.size()));
+        std::vector<unsigned> addresses;
+        config.each<usb2::Endpoint>([&](auto endpoint) {
+            expect(eq(endpoint->wMaxPacketSize.get(), 256));
+            addresses.push_back(endpoint->bEndpointAddress.get());
+        });
+        expect(eq(addresses, std::vector<unsigned>{ 0x80, 0x81, 0x02, 0x83, 0x04 }));
+    };
+    "Truncated configuration"_test = [] {
+        const auto blob = parse::bytes_of(usb2::tests::TestUAC2Configuration_3);
+        const std::vector<uint8_t> dump(blob.begin(), blob.end() - 1);
+        const parse::configuration config { dump };
+        expect(config.error() == parse::error_t::truncated);
+        expect(config.begin() == config.end());
+    };
+    "Class-specific descriptor"_test = [] {
+        unsigned found = 0;
+        parse::chain{audio_streaming}.each<SpeakerStreaming::Header>([&](auto header) {
+            expect(eq(header->bTerminalLink.get(), 5));
+            expect(eq(header->bNrChannels.get(), 2));
+            expect(eq(header.data().data(), audio_streaming.data() + 9));
+            ++found;
+        });
+        expect(eq(found, 1u));
+        for (auto item : parse::chain{audio_streaming})
+            if (item.type() == static_cast<uint8_t>(uac2::ACDescriptorType_t::CS_INTERFACE))
+                expect(eq(item.context().interface_subclass, 2));
+    };
+};
+} // namespace
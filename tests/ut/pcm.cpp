@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ut/pcm.cpp - unit tests for PCM converters
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/pcm.hpp>
+#include <usbplusplus/uac1.hpp>
+#include <usbplusplus/uac2.hpp>
+#include <vector>
+#include "ut.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::ut;
+using namespace boost::ut;
+
+namespace {
+
+constexpr uac2::Type_I_Format_Type Format16 = { {}, {}, {}, {}, 2, 16 };
+constexpr uac2::Type_I_Format_Type Format20in3 = { {}, {}, {}, {}, 3, 20 };
+constexpr uac2::Type_I_Format_Type Format24in3 = { {}, {}, {}, {}, 3, 24 };
+constexpr uac2::Type_I_Format_Type Format24in4 = { {}, {}, {}, {}, 4, 24 };
+constexpr uac2::Type_I_Format_Type Format32 = { {}, {}, {}, {}, 4, 32 };
+constexpr uac1::Type_I_Format_Type<uac1::Type_I_DiscreteSampleFrequency<1>> Format16Mono = {
+    {}, {}, {}, {}, 1, 2, 16, {}, { { 48000 } } };
+
+static_assert(pcm::converter<Format24in3, 2>::frame_size == 6, "Format24in3 frame_size");
+static_assert(pcm::converter<Format20in3, 2>::mask == 0xFFFFF000, "Format20in3 mask");
+static_assert(pcm::converter<Format32, 8>::mask == 0xFFFFFFFF, "Format32 mask");
+static_assert(pcm::converter<Format16Mono>::channels == 1, "Format16Mono channels");
+
+// Pseudo random bytes of a packet
+std::vector<uint8_t> noise(std::size_t size) {
+    std::vector<uint8_t> result(size);
+    uint32_t state = 0x12345678;
+    for(auto& value : result) {
+        state = state * 1664525 + 1013904223;
+        value = static_cast<uint8_t>(state >> 24);
+    }
+    return result;
+}
+
+// Converts a packet to planes and back with native and scalar kernels,
+// frames are chosen to cover the vector loops and the tails
+template<const auto& Format, unsigned Channels, typename Sample>
+void round_trip(std::size_t frames) {
+    using native = pcm::converter<Format, Channels>;
+    using reference = pcm::converter<Format, Channels, pcm::scalar>;
+    const auto packet = noise(frames * native::frame_size);
+    std::vector<Sample> planes[2][Channels];
+    Sample* pointers[2][Channels];
+    for(unsigned i = 0; i < 2; ++i)
+        for(unsigned c = 0; c < Channels; ++c) {
+            planes[i][c].resize(frames);
+            pointers[i][c] = planes[i][c].data();
+        }
+    native::to_planar(packet.data(), frames, pointers[0]);
+    reference::to_planar(packet.data(), frames, pointers[1]);
+    for(unsigned c = 0; c < Channels; ++c)
+        expect(planes[0][c] == planes[1][c]) << "to_planar, channel" << c << "frames" << frames;
+
+    std::vector<uint8_t> packets[2] = {
+        std::vector<uint8_t>(packet.size()), std::vector<uint8_t>(packet.size()) };
+    native::from_planar(pointers[0], frames, packets[0].data());
+    reference::from_planar(pointers[1], frames, packets[1].data());
+    expect(packets[0] == packets[1]) << "from_planar, frames" << frames;
+
+    // Bits below the resolution are lost, the rest survives the round trip,
+    // float keeps 24 bits
+    if( std::is_same_v<Sample, float> && native::bits > 24 ) return;
+    const unsigned dropped = 8 * native::subslot - native::bits;
+    for(std::size_t i = 0; i < packet.size(); ++i) {
+        const unsigned bit = 8 * static_cast<unsigned>(i % native::subslot);
+        const uint8_t mask = bit + 8 <= dropped ? 0 : static_cast<uint8_t>(0xFF << (bit < dropped ? dropped - bit : 0));
+        if( (packets[0][i] ^ packet[i]) & mask ) {
+            expect(eq(packets[0][i] & mask, packet[i] & mask)) << "round trip, byte" << i;
+            break;
+        }
+    }
+}
+
+template<const auto& Format, unsigned Channels>
+void round_trips() {
+    for(std::size_t frames : { 1u, 3u, 7u, 16u, 37u, 256u, 600u }) {
+        round_trip<Format, Channels, int32_t>(frames);
+        round_trip<Format, Channels, float>(frames);
+    }
+}
+
+suite<"PCM"> pcm_suite = [] {
+    "16 bit"_test = [] {
+        const uint8_t packet[] = { 0x34, 0x12, 0x00, 0x80, 0xFF, 0x7F, 0xFF, 0xFF };
+        int32_t left[2], right[2];
+        int32_t* planes[] = { left, right };
+        pcm::converter<Format16, 2>::to_planar(packet, 2, planes);
+        expect(eq(left[0], 0x12340000) and eq(right[0], INT32_MIN));
+        expect(eq(left[1], 0x7FFF0000) and eq(right[1], -0x10000));
+        uint8_t packed[sizeof(packet)] {};
+        pcm::converter<Format16, 2>::from_planar(planes, 2, packed);
+        expect(std::equal(packet, packet + sizeof(packet), packed));
+    };
+    "24 bit in 3 bytes"_test = [] {
+        const uint8_t packet[] = { 0x56, 0x34, 0x12, 0x00, 0x00, 0x80 };
+        int32_t samples[2];
+        int32_t* planes[] = { samples };
+        pcm::converter<Format24in3, 1>::to_planar(packet, 2, planes);
+        expect(eq(samples[0], 0x12345600) and eq(samples[1], INT32_MIN));
+    };
+    "24 bit in 4 bytes"_test = [] {
+        const uint8_t packet[] = { 0xAA, 0x56, 0x34, 0x12 };
+        int32_t samples[1];
+        int32_t* planes[] = { samples };
+        pcm::converter<Format24in4, 1>::to_planar(packet, 1, planes);
+        expect(eq(samples[0], 0x12345600));
+        uint8_t packed[4] {};
+        pcm::converter<Format24in4, 1>::from_planar(planes, 1, packed);
+        expect(eq(packed[0], 0) and eq(packed[3], 0x12));
+    };
+    "Float"_test = [] {
+        const float left[] = { 0.5f, 1.0f, 2.0f };
+        const float right[] = { -0.5f, -1.0f, -2.0f };
+        const float* planes[] = { left, right };
+        uint8_t packet[18] {};
+        pcm::converter<Format24in3, 2>::from_planar(planes, 3, packet);
+        const uint8_t expected[] = {
+            0x00, 0x00, 0x40,   0x00, 0x00, 0xC0,
+            0xFF, 0xFF, 0x7F,   0x00, 0x00, 0x80,
+            0xFF, 0xFF, 0x7F,   0x00, 0x00, 0x80 };
+        expect(std::equal(packet, packet + sizeof(packet), expected));
+        const uint8_t mono[] = { 0x00, 0xC0, 0x00, 0x00, 0x00, 0x40 };
+        float samples[3];
+        float* plane[] = { samples };
+        pcm::converter<Format16Mono>::to_planar(mono, 3, plane);
+        expect(eq(static_cast<int>(samples[0] * 4), -2) and eq(static_cast<int>(samples[1] * 4), 0));
+        expect(eq(static_cast<int>(samples[2] * 4), 2));
+    };
+    "Native kernels"_test = [] {
+        round_trips<Format16, 2>();
+        round_trips<Format20in3, 2>();
+        round_trips<Format24in3, 1>();
+        round_trips<Format24in3, 6>();
+        round_trips<Format24in4, 2>();
+        round_trips<Format32, 8>();
+        round_trips<Format16Mono, 1>();
+    };
+};
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ut/ring.cpp - unit tests for the ring of isochronous audio packets
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/ring.hpp>
+#include <usbplusplus/uac2.hpp>
+#include <memory>
+#include <thread>
+#include "ut.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::ut;
+using namespace boost::ut;
+
+namespace {
+
+constexpr uac2::Type_I_Format_Type Format24in3 = { {}, {}, {}, {}, 3, 24 };
+
+constexpr uac2::AS_Isochronous_Audio_Data_Endpoint FullSpeedEndpoint = {
+    { {}, {}, EndpointAddress(1, EndpointDirection_t::OUT), usb2::Endpoint::Attributes(TransferType_t::Isochronous),
+      MaxPacketSize(270), Interval(1) },
+    {}, {}, {}, uac2::AS_Isochronous_Audio_Data_Endpoint::Attributes(false), {}, uac2::LockDelayUnits_t::Undefined, 0
+};
+
+using Schedule = uac2::PacketSchedule<Format24in3, FullSpeedEndpoint, 2, 44100, BusSpeed_t::Full>;
+using Ring = ring::spsc<Schedule, 4>;
+
+static_assert(Ring::packet_size == 270, "Ring::packet_size");
+static_assert(Ring::stride == 320, "Ring::stride");
+static_assert(alignof(Ring) == ring::cache_line, "alignof(Ring)");
+static_assert(Schedule::interval_us == 1000, "Schedule::interval_us");
+static_assert(ring::spsc<Schedule>::capacity == 8, "ring::spsc<Schedule>::capacity");
+static_assert(ring::packets_for<Schedule>(500) == 2, "ring::packets_for<Schedule>(500)");
+static_assert(ring::packets_for<Schedule>(9000) == 16, "ring::packets_for<Schedule>(9000)");
+
+// Byte of packet n at offset i, for the consumer to check
+uint8_t pattern(uint32_t n, unsigned i) {
+    return static_cast<uint8_t>(n * 7 + i);
+}
+
+suite<"Ring"> ring_suite = [] {
+    "Reserve and commit"_test = [] {
+        auto buffer = std::make_unique<Ring>();
+        expect(buffer->front().empty() and eq(buffer->underruns(), 1u));
+        Schedule schedule {};
+        for(unsigned n = 0; n < Ring::capacity; ++n) {
+            const ring::packet packet = buffer->reserve();
+            expect(! packet.empty() and eq(packet.size, Ring::packet_size));
+            packet.data[0] = static_cast<uint8_t>(n);
+            buffer->commit(schedule.next_bytes());
+        }
+        expect(buffer->reserve().empty() and eq(buffer->overruns(), 1u));
+        expect(eq(buffer->packets(), 4u) and eq(buffer->frames(), 4u * 44));
+
+        const ring::packet first = buffer->front();
+        expect(eq(first.data[0], 0) and eq(first.size, 44u * 6));
+        buffer->release();
+        expect(eq(buffer->packets(), 3u) and eq(buffer->frames(), 3u * 44));
+        const ring::packet next = buffer->reserve();
+        expect(eq(next.data, first.data));
+        expect(eq(buffer->front().data[0], 1));
+    };
+    "Producer and consumer threads"_test = [] {
+        constexpr uint32_t total = 200000;
+        auto buffer = std::make_unique<ring::spsc<Schedule, 8>>();
+        uint32_t most = 0;
+        bool intact = true;
+        std::thread producer([&buffer] {
+            Schedule schedule {};
+            for(uint32_t n = 0; n < total; ) {
+                const ring::packet packet = buffer->reserve();
+                if( packet.empty() ) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const unsigned size = schedule.next_bytes();
+                for(unsigned i = 0; i < size; ++i)
+                    packet.data[i] = pattern(n, i);
+                buffer->commit(size);
+                ++n;
+            }
+        });
+        Schedule schedule {};
+        for(uint32_t n = 0; n < total; ) {
+            const uint32_t frames = buffer->frames();
+            most = frames > most ? frames : most;
+            const ring::packet packet = buffer->front();
+            if( packet.empty() ) {
+                std::this_thread::yield();
+                continue;
+            }
+            intact = intact && packet.size == schedule.next_bytes();
+            for(unsigned i = 0; i < packet.size; ++i)
+                intact = intact && packet.data[i] == pattern(n, i);
+            buffer->release();
+            ++n;
+        }
+        producer.join();
+        expect(intact) << "packets arrive whole and in order";
+        expect(most <= 8u * Schedule::max_frames) << "level within capacity";
+        expect(eq(buffer->frames(), 0u) and eq(buffer->packets(), 0u));
+    };
+};
+}
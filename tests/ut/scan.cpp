@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ut/scan.cpp - unit tests for the batch scanner of configuration dumps
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "../ft/scan.hpp"
+#include <vector>
+#include "configurations.hpp"
+#include "ut.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::ut;
+using namespace boost::ut;
+
+namespace {
+
+constexpr bytes<11> truncated { 0x09, 0x02, 0x12, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x09, 0x04 };
+constexpr bytes<12> overrun { 0x09, 0x02, 0x0C, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x04, 0x24, 0x00 };
+constexpr bytes<12> zero_length { 0x09, 0x02, 0x0C, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x00, 0x24, 0x00 };
+constexpr bytes<12> one_length { 0x09, 0x02, 0x0C, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32, 0x01, 0x24, 0x00 };
+constexpr bytes<9> short_total { 0x09, 0x02, 0x05, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32 };
+constexpr bytes<12> device { 0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40, 0x02, 0x01, 0x04, 0x03 };
+constexpr bytes<4> short_header { 0x09, 0x02, 0x09, 0x00 };
+
+// Corpus of dumps, laid one after another
+struct corpus {
+    template<typename Dump>
+    void add(const Dump& dump) {
+        refs.push_back({ static_cast<uint32_t>(data.size()), static_cast<uint32_t>(dump.size()) });
+        data.insert(data.end(), dump.begin(), dump.end());
+    }
+    std::vector<uint8_t> data {};
+    std::vector<ft::blob_ref> refs {};
+};
+
+suite<"Corpus Scanner"> corpus_scanner_suite = [] {
+    "Malformed lengths"_test = [] {
+        const auto good = parse::bytes_of(usb2::tests::TestUAC2Configuration_3);
+        corpus dumps;
+        dumps.add(good);
+        dumps.add(truncated);
+        dumps.add(overrun);
+        dumps.add(zero_length);
+        dumps.add(one_length);
+        dumps.add(short_total);
+        dumps.add(device);
+        dumps.add(short_header);
+        dumps.add(good);
+        const auto index = ft::scan(dumps.data, dumps.refs);
+        expect(eq(index.blobs.size(), dumps.refs.size()));
+        for (std::size_t i = 0; i < dumps.refs.size(); ++i) {
+            const auto dump = std::span<const uint8_t>{dumps.data}.subspan(dumps.refs[i].offset, dumps.refs[i].size);
+            expect(index.blobs[i].error == parse::validate(dump)) << "blob" << i;
+        }
+        for (std::size_t i : { 2u, 3u, 4u }) {
+            expect(eq(index.blobs[i].count, 1)) << "blob" << i;
+            expect(eq(index.descriptor(dumps.data, dumps.refs, i, 0).type(), 0x02)) << "blob" << i;
+        }
+        for (std::size_t i : { 1u, 5u, 6u, 7u })
+            expect(eq(index.blobs[i].count, 0)) << "blob" << i;
+        for (std::size_t i : { 0u, 8u }) {
+            expect(eq(index.blobs[i].count, 9));
+            expect(eq(index.blobs[i].interfaces, 3));
+            expect(eq(index.blobs[i].endpoints, 5));
+            expect(eq(index.descriptor(dumps.data, dumps.refs, i, 8).data().data(),
+                      dumps.data.data() + dumps.refs[i].offset + good.size() - 7));
+        }
+        expect(eq(index.positions.size(), 2u * 9 + 3));
+    };
+};
+
+}
@@ -9,6 +9,7 @@
 
 #include "strings.hpp"
 #include "ut.hpp"
+#include <algorithm>
 
 using namespace usbplusplus;
 using namespace usbplusplus::usb2;
@@ -29,6 +30,54 @@ suite<"Strings"> strings_suite = [] {
         static constexpr const uint8_t* null{};
         expect(eq(TestStrings::get(100), null));
     };
+    "Packed strings"_test = [] {
+        for (uint8_t i = 0; i <= TestStrings::count; ++i) {
+            const uint8_t* expected = TestStrings::get(i);
+            expect(std::equal(expected, expected + expected[0], TestPackedStrings::get(i))) << "index " << unsigned(i);
+        }
+    };
+    "Packed strings out-of-bounds"_test = [] {
+        static constexpr const uint8_t* null{};
+        expect(eq(TestPackedStrings::get(TestPackedStrings::count + 1), null));
+    };
+    "Fixed string"_test = [] {
+        expect(eq(TestFixedStrings::get(2), u"SuperPuper device"));
+    };
+    "Fixed string longer than ustring"_test = [] {
+        expect(eq(TestFixedStrings::get(3),
+                  u"SuperPuper device with a name, that does not fit in sixty three characters"));
+    };
+    "String from UTF-8"_test = [] {
+        expect(eq(TestFixedStrings::get(4), u"СуперПупер пристрій"));
+        expect(eq(TestFixedStrings::get(5), u"Super😀device"));
+    };
+    "Serial number in hex"_test = [] {
+        const uint8_t uid[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+        sSerialSlot.hex(uid, sizeof(uid));
+        expect(eq(TestSlotStrings::get(2), u"DEADBEEF"));
+        expect(eq(TestSlotStrings::get(1), u"MegaCool Corp."));
+    };
+    "Serial number in base32"_test = [] {
+        StringSlot<base32_length(6)> slot;
+        slot.base32(reinterpret_cast<const uint8_t*>("foobar"), 6);
+        expect(eq(slot.ptr(), u"MZXW6YTBOI"));
+        slot.base32(reinterpret_cast<const uint8_t*>("f"), 1);
+        expect(eq(slot.ptr(), u"MY"));
+    };
+    "String slot truncates"_test = [] {
+        StringSlot<3> slot;
+        slot.assign(u"SuperPuper");
+        expect(eq(slot.ptr(), u"Sup"));
+        const uint8_t uid[] = { 0x01, 0x23 };
+        slot.hex(uid, sizeof(uid));
+        expect(eq(slot.ptr(), u"01"));
+    };
+    "String slot in all languages"_test = [] {
+        sSerialSlot.assign(u"0042");
+        expect(TestSlotMultiStrings::get(2, LanguageIdentifier::English_United_States) == sSerialSlot.ptr());
+        expect(TestSlotMultiStrings::get(2, LanguageIdentifier::Ukrainian) == sSerialSlot.ptr());
+        expect(eq(TestSlotMultiStrings::get(1, LanguageIdentifier::Ukrainian), u"СуперКрута Корп"));
+    };
     "Language List"_test = [] {
         expect(eq(TestMultiStrings::get(0, LanguageIdentifier::English_United_States),
                   bytes<8>{ 0x08, 0x03, 0x09, 0x04, 0x09, 0x08, 0x22, 0x04 }));
@@ -48,6 +97,12 @@ suite<"Strings"> strings_suite = [] {
     "Product in Ukrainian"_test = [] {
         expect(eq(TestMultiStrings::get(2, LanguageIdentifier::Ukrainian), u"СуперПупер пристрій"));
     };
+    "Identical strings are pooled"_test = [] {
+        expect(TestMultiStrings::get(3, LanguageIdentifier::Ukrainian) ==
+               TestMultiStrings::get(3, LanguageIdentifier::English_United_States));
+        expect(TestMultiStrings::get(1, LanguageIdentifier::Ukrainian) !=
+               TestMultiStrings::get(1, LanguageIdentifier::English_United_States));
+    };
     "Manufacturer in default language"_test = [] {
         expect(eq(TestMultiStrings::get(2, LanguageIdentifier::English_Canadian), u"SuperPuper device"));
     };
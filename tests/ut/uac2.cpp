@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2025 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * tests/ut/uac2.cpp - unit tests for UAC2 control request parameter blocks
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <usbplusplus/uac2.hpp>
+#include <vector>
+#include "ut.hpp"
+
+using namespace usbplusplus;
+using namespace usbplusplus::ut;
+using namespace boost::ut;
+
+namespace {
+
+constexpr auto Rates = uac2::sampling_frequency_range<44100, 48000>();
+constexpr auto Volume = uac2::volume_range<-60 * 256, 6 * 256, 128>();
+
+constexpr uac1::Type_I_Format_Type<uac1::Type_I_DiscreteSampleFrequency<2>> DiscreteFormat = {
+    {}, {}, {}, {}, 2, 2, 16, {}, { { 32000, 48000 } }
+};
+constexpr uac1::Type_I_Format_Type<uac1::Type_I_ContinuousSampleFrequency> ContinuousFormat = {
+    {}, {}, {}, {}, 2, 2, 16, {}, { 8000, 96000 }
+};
+constexpr auto DiscreteRates = uac2::sampling_frequency_range_of<DiscreteFormat>();
+constexpr auto ContinuousRates = uac2::sampling_frequency_range_of<ContinuousFormat>();
+
+std::vector<uint8_t> bytes(DescriptorSpan span) {
+    return { span.data, span.data + span.size };
+}
+
+suite<"UAC2 parameter blocks"> uac2_suite = [] {
+    "Sampling frequency RANGE"_test = [] {
+        expect(eq(bytes(Rates.span()), std::vector<uint8_t>{
+            0x02, 0x00,
+            0x44, 0xAC, 0x00, 0x00,   0x44, 0xAC, 0x00, 0x00,   0x00, 0x00, 0x00, 0x00,
+            0x80, 0xBB, 0x00, 0x00,   0x80, 0xBB, 0x00, 0x00,   0x00, 0x00, 0x00, 0x00 }));
+    };
+    "Discrete sampling frequencies of a UAC1 format"_test = [] {
+        expect(eq(bytes(DiscreteRates.span()), std::vector<uint8_t>{
+            0x02, 0x00,
+            0x00, 0x7D, 0x00, 0x00,   0x00, 0x7D, 0x00, 0x00,   0x00, 0x00, 0x00, 0x00,
+            0x80, 0xBB, 0x00, 0x00,   0x80, 0xBB, 0x00, 0x00,   0x00, 0x00, 0x00, 0x00 }));
+    };
+    "Continuous sampling frequencies of a UAC1 format"_test = [] {
+        expect(eq(bytes(ContinuousRates.span()), std::vector<uint8_t>{
+            0x01, 0x00,
+            0x40, 0x1F, 0x00, 0x00,   0x00, 0x77, 0x01, 0x00,   0x01, 0x00, 0x00, 0x00 }));
+    };
+    "Volume RANGE"_test = [] {
+        expect(eq(bytes(Volume.span()), std::vector<uint8_t>{
+            0x01, 0x00,   0x00, 0xC4,   0x00, 0x06,   0x80, 0x00 }));
+    };
+    "Truncated to wLength"_test = [] {
+        const DescriptorSpan head = Rates.span(2);
+        expect(eq(head.size, 2u) and eq(head.data, Rates.span().data));
+        expect(eq(Volume.span(64).size, 8u));
+    };
+};
+}